@@ -17,7 +17,9 @@
 
 #include "addon/addon_manager.hpp"
 
+#include <map>
 #include <physfs.h>
+#include <sstream>
 
 #include "addon/addon.hpp"
 #include "addon/md5.hpp"
@@ -36,6 +38,26 @@ namespace {
 
 static const char* ADDON_INFO_PATH = "/addons/repository.nfo";
 
+/** archives are hashed in reads of this size */
+const size_t MD5_BUFFER_SIZE = 256 * 1024;
+
+const char ADDON_HASH_CACHE[] = "cache/addon-hashes";
+
+/** first line of the cache file, bump the number when the format changes */
+const char ADDON_HASH_CACHE_HEADER[] = "supertux-addon-hashes 1";
+
+struct ArchiveHash
+{
+  PHYSFS_sint64 size;
+  PHYSFS_sint64 mtime;
+  std::string md5;
+};
+
+/** MD5 sums of the add-on archives keyed by their OS path, an entry
+    is only used while the size and modification time of its archive
+    stay the same */
+using HashCache = std::map<std::string, ArchiveHash>;
+
 MD5 md5_from_file(const std::string& filename)
 {
   // TODO: this does not work as expected for some files -- IFileStream seems to not always behave like an ifstream.
@@ -53,12 +75,12 @@ MD5 md5_from_file(const std::string& filename)
   }
   else
   {
+    std::vector<unsigned char> buffer(MD5_BUFFER_SIZE);
     while (true)
     {
-      unsigned char buffer[1024];
-      PHYSFS_sint64 len = PHYSFS_readBytes(file, buffer, sizeof(buffer));
+      PHYSFS_sint64 len = PHYSFS_readBytes(file, buffer.data(), buffer.size());
       if (len <= 0) break;
-      md5.update(buffer, static_cast<unsigned int>(len));
+      md5.update(buffer.data(), static_cast<unsigned int>(len));
     }
     PHYSFS_close(file);
 
@@ -66,6 +88,119 @@ MD5 md5_from_file(const std::string& filename)
   }
 }
 
+/** looks up the OS path, size and modification time of \a archive,
+    given as physfs path */
+bool stat_archive(const std::string& archive, std::string& os_path, PHYSFS_Stat& stat)
+{
+  const char* realdir = PHYSFS_getRealDir(archive.c_str());
+  if (!realdir || !PHYSFS_stat(archive.c_str(), &stat))
+  {
+    return false;
+  }
+  else
+  {
+    os_path = FileSystem::join(realdir, archive);
+    return true;
+  }
+}
+
+HashCache read_hash_cache()
+{
+  HashCache cache;
+
+  // add-ons mounted in front of the user directory must not be able
+  // to supply the sums their archives are checked against
+  if (!PhysFSFileSystem::is_in_write_dir(ADDON_HASH_CACHE))
+  {
+    return cache;
+  }
+
+  PHYSFS_File* file = PHYSFS_openRead(ADDON_HASH_CACHE);
+  if (!file)
+  {
+    return cache;
+  }
+
+  std::string data;
+  const PHYSFS_sint64 length = PHYSFS_fileLength(file);
+  if (length > 0)
+  {
+    data.resize(static_cast<size_t>(length));
+    if (PHYSFS_readBytes(file, &data[0], static_cast<PHYSFS_uint64>(length)) != length)
+    {
+      data.clear();
+    }
+  }
+  PHYSFS_close(file);
+
+  std::istringstream in(data);
+  std::string line;
+  if (!std::getline(in, line) || line != ADDON_HASH_CACHE_HEADER)
+  {
+    log_info << "ignoring outdated add-on hash cache" << std::endl;
+    return cache;
+  }
+
+  while (std::getline(in, line))
+  {
+    std::istringstream entry(line);
+    ArchiveHash hash;
+    std::string os_path;
+    if (entry >> hash.md5 >> hash.size >> hash.mtime &&
+        std::getline(entry >> std::ws, os_path) &&
+        !os_path.empty())
+    {
+      cache[os_path] = hash;
+    }
+  }
+
+  return cache;
+}
+
+void write_hash_cache(const HashCache& cache)
+{
+  std::ostringstream out;
+  out << ADDON_HASH_CACHE_HEADER << '\n';
+  for(const auto& entry : cache)
+  {
+    out << entry.second.md5 << ' ' << entry.second.size << ' ' << entry.second.mtime
+        << ' ' << entry.first << '\n';
+  }
+  const std::string data = out.str();
+
+  // the cache only saves time, so failing to write it is no error
+  if (!PHYSFS_mkdir("cache"))
+  {
+    log_warning << "Couldn't create directory 'cache': " << PHYSFS_getLastErrorCode() << std::endl;
+    return;
+  }
+
+  PHYSFS_File* file = PHYSFS_openWrite(ADDON_HASH_CACHE);
+  if (!file ||
+      PHYSFS_writeBytes(file, data.data(), data.size()) != static_cast<PHYSFS_sint64>(data.size()))
+  {
+    log_warning << "Couldn't write '" << ADDON_HASH_CACHE << "': " << PHYSFS_getLastErrorCode() << std::endl;
+  }
+  if (file)
+  {
+    PHYSFS_close(file);
+  }
+}
+
+/** stores the MD5 sum of a freshly installed archive, so that it
+    doesn't get hashed again on the next start */
+void remember_archive_hash(const std::string& archive, const std::string& md5)
+{
+  std::string os_path;
+  PHYSFS_Stat stat;
+  if (stat_archive(archive, os_path, stat))
+  {
+    HashCache cache = read_hash_cache();
+    cache[os_path] = { stat.filesize, stat.modtime, md5 };
+    write_hash_cache(cache);
+  }
+}
+
 static Addon& get_addon(const AddonManager::AddonList& list, const AddonId& id,
                         bool installed)
 {
@@ -122,8 +257,64 @@ static PHYSFS_EnumerateCallbackResult remove_from_dictionary_path(void *data, co
 }
 } // namespace
 
+AddonManager::ArchiveList
+AddonManager::scan_archives(const std::string& addon_directory)
+{
+  const HashCache cache = read_hash_cache();
+  HashCache new_cache;
+  bool cache_changed = false;
+
+  ArchiveList archives;
+  for(const auto& archive : scan_for_archives(addon_directory))
+  {
+    std::string os_path;
+    PHYSFS_Stat stat;
+    const bool has_stat = stat_archive(archive, os_path, stat);
+
+    std::string md5;
+    if (has_stat)
+    {
+      auto it = cache.find(os_path);
+      if (it != cache.end() &&
+          it->second.size == stat.filesize &&
+          it->second.mtime == stat.modtime)
+      {
+        md5 = it->second.md5;
+      }
+    }
+
+    if (md5.empty())
+    {
+      log_debug << "hashing add-on archive " << archive << std::endl;
+      md5 = md5_from_file(archive).hex_digest();
+      cache_changed = true;
+    }
+
+    if (has_stat)
+    {
+      new_cache[os_path] = { stat.filesize, stat.modtime, md5 };
+    }
+    archives.emplace_back(archive, md5);
+  }
+
+  // also drops the entries of archives that are gone
+  if (cache_changed || new_cache.size() != cache.size())
+  {
+    write_hash_cache(new_cache);
+  }
+
+  return archives;
+}
+
 AddonManager::AddonManager(const std::string& addon_directory,
                            std::vector<Config::Addon>& addon_config) :
+  AddonManager(addon_directory, addon_config, scan_archives(addon_directory))
+{
+}
+
+AddonManager::AddonManager(const std::string& addon_directory,
+                           std::vector<Config::Addon>& addon_config,
+                           const ArchiveList& archives) :
   m_downloader(),
   m_addon_directory(addon_directory),
   m_repository_url("https://raw.githubusercontent.com/SuperTux/addons/master/index-0_5.nfo"),
@@ -141,7 +332,7 @@ AddonManager::AddonManager(const std::string& addon_directory,
     throw std::runtime_error(msg.str());
   }
 
-  add_installed_addons();
+  add_installed_addons(archives);
 
   // FIXME: We should also restore the order here
   for(auto& addon : m_addon_config)
@@ -303,6 +494,8 @@ AddonManager::request_install_addon(const AddonId& addon_id)
     m_transfer_status->then(
       [this, install_filename, addon_id](bool success)
       {
+        // hashed while downloading
+        const std::string md5 = m_transfer_status->md5;
         m_transfer_status = {};
 
         if (success)
@@ -310,8 +503,7 @@ AddonManager::request_install_addon(const AddonId& addon_id)
           // complete the addon install
           Addon& repository_addon = get_repository_addon(addon_id);
 
-          MD5 md5 = md5_from_file(install_filename);
-          if (repository_addon.get_md5() != md5.hex_digest())
+          if (repository_addon.get_md5() != md5)
           {
             if (PHYSFS_delete(install_filename.c_str()) == 0)
             {
@@ -329,7 +521,8 @@ AddonManager::request_install_addon(const AddonId& addon_id)
             }
             else
             {
-              add_installed_archive(install_filename, md5.hex_digest());
+              remember_archive_hash(install_filename, md5);
+              add_installed_archive(install_filename, md5);
             }
           }
         }
@@ -367,10 +560,8 @@ AddonManager::install_addon(const AddonId& addon_id)
 
   std::string install_filename = FileSystem::join(m_addon_directory, repository_addon.get_filename());
 
-  m_downloader.download(repository_addon.get_url(), install_filename);
-
-  MD5 md5 = md5_from_file(install_filename);
-  if (repository_addon.get_md5() != md5.hex_digest())
+  const std::string md5 = m_downloader.download(repository_addon.get_url(), install_filename);
+  if (repository_addon.get_md5() != md5)
   {
     if (PHYSFS_delete(install_filename.c_str()) == 0)
     {
@@ -388,7 +579,8 @@ AddonManager::install_addon(const AddonId& addon_id)
     }
     else
     {
-      add_installed_archive(install_filename, md5.hex_digest());
+      remember_archive_hash(install_filename, md5);
+      add_installed_archive(install_filename, md5);
     }
   }
 }
@@ -552,19 +744,19 @@ AddonManager::is_from_old_addon(const std::string& filename) const
 }
 
 std::vector<std::string>
-AddonManager::scan_for_archives() const
+AddonManager::scan_for_archives(const std::string& addon_directory)
 {
   std::vector<std::string> archives;
 
   // Search for archives and add them to the search path
   std::unique_ptr<char*, decltype(&PHYSFS_freeList)>
-    rc(PHYSFS_enumerateFiles(m_addon_directory.c_str()),
+    rc(PHYSFS_enumerateFiles(addon_directory.c_str()),
        PHYSFS_freeList);
   for(char** i = rc.get(); *i != nullptr; ++i)
   {
     if (StringUtil::has_suffix(*i, ".zip"))
     {
-      std::string archive = FileSystem::join(m_addon_directory, *i);
+      std::string archive = FileSystem::join(addon_directory, *i);
       if (PHYSFS_exists(archive.c_str()))
       {
         archives.push_back(archive);
@@ -646,14 +838,11 @@ AddonManager::add_installed_archive(const std::string& archive, const std::strin
 }
 
 void
-AddonManager::add_installed_addons()
+AddonManager::add_installed_addons(const ArchiveList& archives)
 {
-  auto archives = scan_for_archives();
-
   for(const auto& archive : archives)
   {
-    MD5 md5 = md5_from_file(archive);
-    add_installed_archive(archive, md5.hex_digest());
+    add_installed_archive(archive.first, archive.second);
   }
 }
 
@@ -20,6 +20,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "addon/downloader.hpp"
@@ -37,6 +38,9 @@ class AddonManager final : public Currenton<AddonManager>
 public:
   using AddonList = std::vector<std::unique_ptr<Addon> >;
 
+  /** physfs filename and MD5 sum of each installed add-on archive */
+  using ArchiveList = std::vector<std::pair<std::string, std::string> >;
+
 private:
   Downloader m_downloader;
   std::string m_addon_directory;
@@ -53,8 +57,19 @@ private:
 public:
   AddonManager(const std::string& addon_directory,
                std::vector<Config::Addon>& addon_config);
+
+  /** Uses the archives from an earlier scan_archives() instead of
+      scanning the directory again */
+  AddonManager(const std::string& addon_directory,
+               std::vector<Config::Addon>& addon_config,
+               const ArchiveList& archives);
   ~AddonManager();
 
+  /** Finds the add-on archives in \a addon_directory and computes
+      their MD5 sums. It only reads files, so it can run on another
+      thread while the rest of the game starts up. */
+  static ArchiveList scan_archives(const std::string& addon_directory);
+
   bool has_online_support() const;
   bool has_been_updated() const;
   void check_online();
@@ -84,8 +99,8 @@ public:
   void check_for_langpack_updates();
 
 private:
-  std::vector<std::string> scan_for_archives() const;
-  void add_installed_addons();
+  static std::vector<std::string> scan_for_archives(const std::string& addon_directory);
+  void add_installed_addons(const ArchiveList& archives);
   AddonList parse_addon_infos(const std::string& filename) const;
 
   /** add \a archive, given as physfs path, to the list of installed
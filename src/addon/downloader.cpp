@@ -26,6 +26,7 @@
 #include <stdexcept>
 #include <version.h>
 
+#include "addon/md5.hpp"
 #include "util/log.hpp"
 
 namespace {
@@ -39,17 +40,25 @@ size_t my_curl_string_append(void* ptr, size_t size, size_t nmemb, void* userdat
   return size * nmemb;
 }
 
+struct PhysFSDownload
+{
+  PHYSFS_file* file;
+  MD5 md5;
+};
+
 size_t my_curl_physfs_write(void* ptr, size_t size, size_t nmemb, void* userdata)
 {
-  PHYSFS_file* f = static_cast<PHYSFS_file*>(userdata);
-  PHYSFS_sint64 written = PHYSFS_writeBytes(f, ptr, size * nmemb);
+  PhysFSDownload& download = *static_cast<PhysFSDownload*>(userdata);
+  PHYSFS_sint64 written = PHYSFS_writeBytes(download.file, ptr, size * nmemb);
   log_debug << "read " << size * nmemb << " bytes of data..." << std::endl;
-  if (written < 0)
+  if (written <= 0)
   {
     return 0;
   }
   else
   {
+    // only what made it to the file counts towards the sum
+    download.md5.update(static_cast<uint8_t*>(ptr), static_cast<unsigned int>(written));
     return static_cast<size_t>(written);
   }
 }
@@ -81,6 +90,10 @@ private:
   TransferStatusPtr m_status;
   std::unique_ptr<PHYSFS_file, int(*)(PHYSFS_File*)> m_fout;
 
+  /** the data is hashed as it arrives, so that it doesn't have to be
+      read back from the file for the checksum test */
+  MD5 m_md5;
+
 public:
   Transfer(Downloader& downloader, TransferId id,
            const std::string& url,
@@ -91,7 +104,8 @@ public:
     m_handle(),
     m_error_buffer({{'\0'}}),
     m_status(new TransferStatus(m_downloader, id)),
-    m_fout(PHYSFS_openWrite(outfile.c_str()), PHYSFS_close)
+    m_fout(PHYSFS_openWrite(outfile.c_str()), PHYSFS_close),
+    m_md5()
   {
     if (!m_fout)
     {
@@ -154,10 +168,25 @@ public:
     return m_url;
   }
 
+  std::string get_md5()
+  {
+    return m_md5.hex_digest();
+  }
+
   size_t on_data(void* ptr, size_t size, size_t nmemb)
   {
-    PHYSFS_writeBytes(m_fout.get(), ptr, size * nmemb);
-    return size * nmemb;
+    // a short write makes curl fail the transfer, so a truncated file
+    // never gets the sum of the complete download
+    PHYSFS_sint64 written = PHYSFS_writeBytes(m_fout.get(), ptr, size * nmemb);
+    if (written <= 0)
+    {
+      return 0;
+    }
+    else
+    {
+      m_md5.update(static_cast<uint8_t*>(ptr), static_cast<unsigned int>(written));
+      return static_cast<size_t>(written);
+    }
   }
 
   int on_progress(double dltotal, double dlnow,
@@ -252,13 +281,15 @@ Downloader::download(const std::string& url)
   return result;
 }
 
-void
+std::string
 Downloader::download(const std::string& url, const std::string& filename)
 {
   log_info << "download: " << url << " to " << filename << std::endl;
   std::unique_ptr<PHYSFS_file, int(*)(PHYSFS_File*)> fout(PHYSFS_openWrite(filename.c_str()),
                                                           PHYSFS_close);
-  download(url, my_curl_physfs_write, fout.get());
+  PhysFSDownload data = { fout.get(), MD5() };
+  download(url, my_curl_physfs_write, &data);
+  return data.md5.hex_digest();
 }
 
 void
@@ -325,6 +356,7 @@ Downloader::update()
           assert(it != m_transfers.end());
           TransferStatusPtr status = (*it)->get_status();
           status->error_msg = (*it)->get_error_buffer();
+          status->md5 = (*it)->get_md5();
           m_transfers.erase(it);
 
           if (resultfromcurl == CURLE_OK)
@@ -42,6 +42,9 @@ public:
 
   std::string error_msg;
 
+  /** MD5 sum of the downloaded data, set when the transfer is done */
+  std::string md5;
+
   TransferStatus(Downloader& downloader, TransferId id_) :
     m_downloader(downloader),
     id(id_),
@@ -50,7 +53,8 @@ public:
     dlnow(0),
     ultotal(0),
     ulnow(0),
-    error_msg()
+    error_msg(),
+    md5()
   {}
 
   void abort();
@@ -80,8 +84,9 @@ public:
   /** Download \a url and return the result as string */
   std::string download(const std::string& url);
 
-  /** Download \a url and store the result in \a filename */
-  void download(const std::string& url, const std::string& filename);
+  /** Download \a url and store the result in \a filename, returns
+      the MD5 sum of the data */
+  std::string download(const std::string& url, const std::string& filename);
 
   void download(const std::string& url,
                 size_t (*write_func)(void* ptr, size_t size, size_t nmemb, void* userdata),
@@ -17,6 +17,7 @@
 #include "editor/editor.hpp"
 
 #include <limits>
+#include <sstream>
 
 //#include "addon/addon_manager.hpp"
 #include "audio/sound_manager.hpp"
@@ -33,6 +34,7 @@
 #include "object/camera.hpp"
 #include "object/player.hpp"
 #include "object/tilemap.hpp"
+#include "physfs/ofile_stream.hpp"
 #include "physfs/physfs_file_system.cpp"
 #include "supertux/game_manager.hpp"
 #include "supertux/level.hpp"
@@ -47,6 +49,8 @@
 #include "supertux/tile_manager.hpp"
 #include "supertux/world.hpp"
 #include "util/file_system.hpp"
+#include "util/log.hpp"
+#include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
 #include "video/compositor.hpp"
 #include "video/drawing_context.hpp"
@@ -76,11 +80,19 @@ Editor::Editor() :
   tileselect(),
   layerselect(),
   scroller(),
+  undo_manager(),
   enabled(false),
-  bgr_surface(Surface::from_file("images/background/forest1.jpg"))
+  bgr_surface(Surface::from_file("images/background/forest1.jpg")),
+  test_level_session_file(),
+  test_level_backup()
 {
 }
 
+Editor::~Editor()
+{
+  finish_test_level();
+}
+
 void Editor::draw(Compositor& compositor)
 {
   auto& context = compositor.make_context();
@@ -92,7 +104,7 @@ void Editor::draw(Compositor& compositor)
                                      Color(0.0f, 0.0f, 0.0f),
                                      0.0f, std::numeric_limits<int>::min());
   } else {
-    context.color().draw_surface_scaled(bgr_surface,
+    context.color().draw_surface_scaled(*bgr_surface,
                                         Rectf(Vector(0, 0), Vector(static_cast<float>(context.get_width()),
                                                                    static_cast<float>(context.get_height()))),
                                         -100);
@@ -159,6 +171,7 @@ void Editor::test_level() {
   Tile::draw_editor_images = false;
   Compositor::s_render_lighting = true;
   auto backup_filename = levelfile + "~";
+  std::unique_ptr<World> test_world;
   if(world != nullptr)
   {
     auto basedir = world->get_basedir();
@@ -167,7 +180,32 @@ void Editor::test_level() {
       basedir = PHYSFS_getRealDir(levelfile.c_str());
     }
     test_levelfile = FileSystem::join(basedir, backup_filename);
-    level->save(test_levelfile);
+    test_level_session_file = FileSystem::join(world->get_basedir(), backup_filename);
+  }
+  else
+  {
+    auto directory = FileSystem::dirname(levelfile);
+    test_levelfile = FileSystem::join(directory, backup_filename);
+    test_level_session_file = test_levelfile;
+    test_world = World::load(directory);
+  }
+
+  // Hand the level to the game in memory, parsed only once no matter
+  // how often it gets restarted. The file is just a backup in case
+  // the game crashes while testing, so it is written in the background.
+  std::ostringstream out;
+  level->save(out);
+  std::string data = out.str();
+  {
+    std::istringstream in(data);
+    auto doc = ReaderDocument::from_stream(in, test_levelfile);
+    ReaderDocument::add_memory_file(test_levelfile, doc);
+    ReaderDocument::add_memory_file(test_level_session_file, doc);
+  }
+  save_test_level_backup(std::move(data));
+
+  if(world != nullptr)
+  {
     if(!worldmap_mode)
     {
       GameManager::current()->start_level(world.get(), backup_filename);
@@ -179,10 +217,6 @@ void Editor::test_level() {
   }
   else
   {
-    auto directory = FileSystem::dirname(levelfile);
-    test_levelfile = FileSystem::join(directory, backup_filename);
-    level->save(test_levelfile);
-    std::unique_ptr<World> test_world = World::load(directory);
     if(!worldmap_mode)
     {
       GameManager::current()->start_level(std::move(test_world), backup_filename);
@@ -195,6 +229,32 @@ void Editor::test_level() {
   leveltested = true;
 }
 
+void Editor::save_test_level_backup(std::string data) {
+  if (test_level_backup.joinable()) {
+    test_level_backup.join();
+  }
+
+  test_level_backup = std::thread([filename = test_levelfile, data = std::move(data)] {
+    try {
+      OFileStream out(filename);
+      out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    } catch(const std::exception& e) {
+      log_warning << "Couldn't write backup of the tested level: " << e.what() << std::endl;
+    }
+  });
+}
+
+void Editor::finish_test_level() {
+  if (test_level_backup.joinable()) {
+    test_level_backup.join();
+  }
+
+  if (!test_levelfile.empty()) {
+    ReaderDocument::remove_memory_file(test_levelfile);
+    ReaderDocument::remove_memory_file(test_level_session_file);
+  }
+}
+
 void Editor::set_world(std::unique_ptr<World> w) {
   world = std::move(w);
 }
@@ -354,6 +414,7 @@ void Editor::reload_level() {
   enabled = true;
   tileselect.input_type = EditorInputGui::IP_NONE;
   // Re/load level
+  undo_manager.clear();
   level = nullptr;
   levelloaded = true;
 
@@ -426,6 +487,7 @@ Editor::setup() {
 
   // Reactivate the editor after level test
   if (leveltested) {
+    finish_test_level();
     if(!test_levelfile.empty())
     {
       // Try to remove the test level using the PhysFS file system
@@ -464,6 +526,18 @@ Editor::event(SDL_Event& ev) {
       Compositor::s_render_lighting = !Compositor::s_render_lighting;
     }
 
+    if (ev.type == SDL_KEYDOWN && (ev.key.keysym.mod & KMOD_CTRL)) {
+      if (ev.key.keysym.sym == SDLK_z && !(ev.key.keysym.mod & KMOD_SHIFT)) {
+        undo();
+        return;
+      }
+      if (ev.key.keysym.sym == SDLK_y ||
+          (ev.key.keysym.sym == SDLK_z && (ev.key.keysym.mod & KMOD_SHIFT))) {
+        redo();
+        return;
+      }
+    }
+
     if ( tileselect.event(ev) ) {
       return;
     }
@@ -479,6 +553,43 @@ Editor::event(SDL_Event& ev) {
   }
 }
 
+void
+Editor::undo() {
+  if (undo_manager.is_action_open()) {
+    return;
+  }
+
+  auto sector = undo_manager.undo();
+  if (sector) {
+    show_changed_sector(sector);
+  }
+}
+
+void
+Editor::redo() {
+  if (undo_manager.is_action_open()) {
+    return;
+  }
+
+  auto sector = undo_manager.redo();
+  if (sector) {
+    show_changed_sector(sector);
+  }
+}
+
+void
+Editor::show_changed_sector(Sector* sector) {
+  if (sector != currentsector) {
+    for (size_t i = 0; i < level->get_sector_count(); ++i) {
+      if (level->get_sector(i) == sector) {
+        load_sector(i);
+        break;
+      }
+    }
+  }
+  sort_layers();
+}
+
 bool
 Editor::is_active() {
   auto self = Editor::current();
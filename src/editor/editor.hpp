@@ -18,11 +18,13 @@
 #define HEADER_SUPERTUX_EDITOR_EDITOR_HPP
 
 #include <string>
+#include <thread>
 
 #include "editor/input_center.hpp"
 #include "editor/input_gui.hpp"
 #include "editor/layers_gui.hpp"
 #include "editor/scroller.hpp"
+#include "editor/undo_manager.hpp"
 #include "supertux/screen.hpp"
 #include "util/currenton.hpp"
 #include "video/surface_ptr.hpp"
@@ -41,6 +43,7 @@ class Editor final : public Screen,
 {
   public:
     Editor();
+    ~Editor();
 
     virtual void draw(Compositor&) override;
     virtual void update(float dt_sec) override;
@@ -170,6 +173,11 @@ class Editor final : public Screen,
 
     GameObject* get_selected_tilemap() const { return layerselect.selected_tilemap; }
 
+    UndoManager& get_undo_manager() { return undo_manager; }
+
+    void undo();
+    void redo();
+
   protected:
     bool levelloaded;
     bool leveltested;
@@ -180,15 +188,26 @@ class Editor final : public Screen,
     EditorInputGui tileselect;
     EditorLayersGui layerselect;
     EditorScroller scroller;
+    UndoManager undo_manager;
 
   private:
     bool enabled;
     SurfacePtr bgr_surface;
 
+    /** name the game session loads the tested level from, it is
+        handed over in memory under this name and test_levelfile */
+    std::string test_level_session_file;
+
+    /** writes test_levelfile as a backup while the level is tested */
+    std::thread test_level_backup;
+
     void reload_level();
     void load_layers();
     void quit_editor();
     void test_level();
+    void save_test_level_backup(std::string data);
+    void finish_test_level();
+    void show_changed_sector(Sector* sector);
     void update_keyboard();
 
     bool can_scroll_horz() const;
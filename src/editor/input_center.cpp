@@ -44,6 +44,7 @@ EditorInputCenter::EditorInputCenter() :
   mouse_pos(0, 0),
   dragging(false),
   dragging_right(false),
+  undo_action_open(false),
   drag_start(0, 0),
   dragged_object(nullptr),
   hovered_object(nullptr),
@@ -125,12 +126,19 @@ EditorInputCenter::input_tile(const Vector& pos, uint32_t tile) {
     return;
   }
 
+  Editor::current()->get_undo_manager().record_tiles(*tilemap, static_cast<int>(pos.x), static_cast<int>(pos.y), 1);
   tilemap->change(static_cast<int>(pos.x), static_cast<int>(pos.y), tile);
 }
 
 void
 EditorInputCenter::put_tile() {
+  auto tilemap = dynamic_cast<TileMap*>(Editor::current()->get_selected_tilemap());
+  if ( !tilemap ) {
+    return;
+  }
+
   auto tiles = Editor::current()->get_tiles();
+  tilemap->begin_changes();
   Vector add_tile;
   for (add_tile.x = static_cast<float>(tiles->width) - 1.0f; add_tile.x >= 0.0f; add_tile.x--) {
     for (add_tile.y = static_cast<float>(tiles->height) - 1.0f; add_tile.y >= 0; add_tile.y--) {
@@ -138,17 +146,24 @@ EditorInputCenter::put_tile() {
                                                      static_cast<int>(add_tile.y)));
     }
   }
+  tilemap->end_changes();
 }
 
 void
 EditorInputCenter::draw_rectangle() {
 
+  auto tilemap = dynamic_cast<TileMap*>(Editor::current()->get_selected_tilemap());
+  if ( !tilemap ) {
+    return;
+  }
+
   Rectf dr = drag_rect();
   dr.p1 = sp_to_tp(dr.p1);
   dr.p2 = sp_to_tp(dr.p2);
   bool sgn_x = drag_start.x < sector_pos.x;
   bool sgn_y = drag_start.y < sector_pos.y;
 
+  tilemap->begin_changes();
   int x_ = sgn_x ? 0 : static_cast<int>(-dr.get_width());
   for (int x = static_cast<int>(dr.p1.x); x <= static_cast<int>(dr.p2.x); x++, x_++) {
     int y_ = sgn_y ? 0 : static_cast<int>(-dr.get_height());
@@ -156,6 +171,7 @@ EditorInputCenter::draw_rectangle() {
       input_tile( Vector(static_cast<float>(x), static_cast<float>(y)), Editor::current()->get_tiles()->pos(x_, y_) );
     }
   }
+  tilemap->end_changes();
 }
 
 void
@@ -168,85 +184,81 @@ EditorInputCenter::fill() {
     return;
   }
 
+  const int width = tilemap->get_width();
+  const int height = tilemap->get_height();
+  const int start_x = static_cast<int>(hovered_tile.x);
+  const int start_y = static_cast<int>(hovered_tile.y);
+  if (start_x < 0 || start_y < 0 || start_x >= width || start_y >= height) {
+    return;
+  }
+
   // The tile that is going to be replaced:
-  Uint32 replace_tile = tilemap->get_tile_id(static_cast<int>(hovered_tile.x), static_cast<int>(hovered_tile.y));
+  Uint32 replace_tile = tilemap->get_tile_id(start_x, start_y);
 
   if (replace_tile == tiles->pos(0, 0)) {
     // Replacing by the same tiles shouldn't do anything.
     return;
   }
 
-  std::vector<Vector> pos_stack;
-  pos_stack.clear();
-  pos_stack.push_back(hovered_tile);
+  // The selection may contain replace_tile itself, so filled tiles
+  // can't be told apart by their id and get marked instead.
+  std::vector<bool> filled(static_cast<size_t>(width) * static_cast<size_t>(height), false);
+  auto fillable = [&](int x, int y) {
+    return !filled[y * width + x] && tilemap->get_tile_id(x, y) == replace_tile;
+  };
 
-  // Passing recursively trough all tiles to be replaced...
-  while (pos_stack.size()) {
+  std::vector<std::pair<int, int> > seeds;
+  seeds.emplace_back(start_x, start_y);
+  std::vector<uint32_t> span;
 
-    if (pos_stack.size() > 1000000) {
-      log_warning << "More than 1'000'000 tiles in stack to fill, STOP" << std::endl;
-      return;
-    }
+  tilemap->begin_changes();
+  while (!seeds.empty()) {
+    const int x = seeds.back().first;
+    const int y = seeds.back().second;
+    seeds.pop_back();
 
-    Vector pos = pos_stack[pos_stack.size() - 1];
-    Vector tpos = pos - hovered_tile;
-
-    // Tests for being inside tilemap:
-    if ( pos.x < 0 ||
-         pos.y < 0 ||
-         pos.x >= static_cast<float>(tilemap->get_width()) ||
-         pos.y >= static_cast<float>(tilemap->get_height()))
-    {
-      pos_stack.pop_back();
+    if (!fillable(x, y)) {
       continue;
     }
 
-    input_tile(pos, tiles->pos(static_cast<int>(tpos.x), static_cast<int>(tpos.y)));
-    Vector pos_;
-
-    // Going left...
-    pos_ = pos + Vector(-1, 0);
-    if (pos_.x >= 0) {
-      if (replace_tile == tilemap->get_tile_id(static_cast<int>(pos_.x), static_cast<int>(pos_.y)) &&
-          replace_tile != tiles->pos(static_cast<int>(tpos.x - 1), static_cast<int>(tpos.y))) {
-        pos_stack.push_back( pos_ );
-        continue;
-      }
+    // Extend the seed to the whole run of fillable tiles in its row...
+    int left = x;
+    while (left > 0 && fillable(left - 1, y)) {
+      left--;
     }
-
-    // Going right...
-    pos_ = pos + Vector(1, 0);
-    if (pos_.x < static_cast<float>(tilemap->get_width())) {
-      if (replace_tile == tilemap->get_tile_id(static_cast<int>(pos_.x), static_cast<int>(pos_.y)) &&
-          replace_tile != tiles->pos(static_cast<int>(tpos.x + 1), static_cast<int>(tpos.y))) {
-        pos_stack.push_back( pos_ );
-        continue;
-      }
+    int right = x;
+    while (right < width - 1 && fillable(right + 1, y)) {
+      right++;
     }
 
-    // Going up...
-    pos_ = pos + Vector(0, -1);
-    if (pos_.y >= 0) {
-      if (replace_tile == tilemap->get_tile_id(static_cast<int>(pos_.x), static_cast<int>(pos_.y))&&
-          replace_tile != tiles->pos(static_cast<int>(tpos.x), static_cast<int>(tpos.y - 1))) {
-        pos_stack.push_back( pos_ );
-        continue;
-      }
+    // ...fill it with the selection, aligned to the hovered tile...
+    span.resize(right - left + 1);
+    for (int i = left; i <= right; ++i) {
+      filled[y * width + i] = true;
+      span[i - left] = tiles->pos(i - start_x, y - start_y);
     }
+    editor->get_undo_manager().record_tiles(*tilemap, left, y, right - left + 1);
+    tilemap->change_span(left, y, span);
 
-    // Going down...
-    pos_ = pos + Vector(0, 1);
-    if (pos_.y < static_cast<float>(tilemap->get_height())) {
-      if (replace_tile == tilemap->get_tile_id(static_cast<int>(pos_.x), static_cast<int>(pos_.y)) &&
-          replace_tile != tiles->pos(static_cast<int>(tpos.x), static_cast<int>(tpos.y + 1))) {
-        pos_stack.push_back( pos_ );
+    // ...and seed every fillable run above and below it.
+    for (int ny = y - 1; ny <= y + 1; ny += 2) {
+      if (ny < 0 || ny >= height) {
         continue;
       }
+      bool in_run = false;
+      for (int i = left; i <= right; ++i) {
+        if (fillable(i, ny)) {
+          if (!in_run) {
+            seeds.emplace_back(i, ny);
+            in_run = true;
+          }
+        } else {
+          in_run = false;
+        }
+      }
     }
-
-    // When tiles on each side are already filled or occupied by another tiles, it ends.
-    pos_stack.pop_back();
   }
+  tilemap->end_changes();
 }
 
 void
@@ -514,6 +526,7 @@ EditorInputCenter::process_left_click() {
   drag_start = sector_pos;
   switch (Editor::current()->get_tileselect_input_type()) {
     case EditorInputGui::IP_TILE: {
+      begin_undo_action();
       switch (Editor::current()->get_tileselect_select_mode()) {
         case 0:
           put_tile();
@@ -552,6 +565,24 @@ EditorInputCenter::process_left_click() {
   }
 }
 
+void
+EditorInputCenter::begin_undo_action() {
+  // the release of the previous click might have gone to another widget
+  end_undo_action();
+
+  auto editor = Editor::current();
+  editor->get_undo_manager().begin_action(*editor->currentsector);
+  undo_action_open = true;
+}
+
+void
+EditorInputCenter::end_undo_action() {
+  if (undo_action_open) {
+    Editor::current()->get_undo_manager().end_action();
+    undo_action_open = false;
+  }
+}
+
 void
 EditorInputCenter::process_right_click() {
   switch (Editor::current()->get_tileselect_input_type()) {
@@ -634,6 +665,7 @@ EditorInputCenter::event(SDL_Event& ev) {
 
     case SDL_MOUSEBUTTONUP:
       dragging = false;
+      end_undo_action();
       break;
 
     case SDL_MOUSEMOTION:
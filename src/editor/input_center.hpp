@@ -58,6 +58,7 @@ class EditorInputCenter final
 
     bool dragging;
     bool dragging_right;
+    bool undo_action_open; /**< the tiles changed by the drag form one undo step */
     Vector drag_start;
     MovingObject* dragged_object;
     MovingObject* hovered_object;
@@ -90,6 +91,8 @@ class EditorInputCenter final
     void draw_path(DrawingContext&);
 
     void process_left_click();
+    void begin_undo_action();
+    void end_undo_action();
     void process_right_click();
 
     // sp is sector pos, tp is pos on tilemap.
@@ -52,7 +52,7 @@ LayerIcon::draw(DrawingContext& context, const Vector& pos) {
                                 pos + Vector(16,16),
                                 ALIGN_CENTER, LAYER_GUI, ColorScheme::Menu::default_color);
     if (is_tilemap) if ((static_cast<TileMap*>(layer))->m_editor_active) {
-        context.color().draw_surface(selection, pos, LAYER_GUI - 1);
+        context.color().draw_surface(*selection, pos, LAYER_GUI - 1);
     }
   }
 }
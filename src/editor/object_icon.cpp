@@ -61,7 +61,7 @@ ObjectIcon::calculate_offset() {
 
 void
 ObjectIcon::draw(DrawingContext& context, const Vector& pos) {
-  context.color().draw_surface_scaled(surface,
+  context.color().draw_surface_scaled(*surface,
                                       Rectf(pos + offset, pos + Vector(32,32) - offset), LAYER_GUI - 9);
 }
 
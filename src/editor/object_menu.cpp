@@ -25,6 +25,12 @@
 ObjectMenu::ObjectMenu(GameObject *go) :
   object(go)
 {
+  auto editor = Editor::current();
+  if (editor) {
+    editor->get_undo_manager().begin_action(*editor->currentsector);
+    editor->get_undo_manager().record_settings(*object);
+  }
+
   ObjectSettings os = object->get_settings();
   add_label(os.name);
   add_hl();
@@ -84,6 +90,7 @@ ObjectMenu::~ObjectMenu()
   if(editor == nullptr) {
     return;
   }
+  editor->get_undo_manager().end_action();
   editor->reactivate_request = true;
   if (! dynamic_cast<MovingObject*>(object)) {
     editor->sort_layers();
@@ -37,7 +37,7 @@ ToolIcon::push_mode(const std::string& icon) {
 
 void
 ToolIcon::draw(DrawingContext& context) {
-  context.color().draw_surface(surfaces[mode], pos, LAYER_GUI - 9);
+  context.color().draw_surface(*surfaces[mode], pos, LAYER_GUI - 9);
 }
 
 void
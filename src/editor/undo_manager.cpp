@@ -0,0 +1,436 @@
+//  SuperTux
+//  Copyright (C) 2018 Ingo Ruhnke <grumbel@gmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "editor/undo_manager.hpp"
+
+#include <algorithm>
+#include <assert.h>
+
+#include "editor/object_settings.hpp"
+#include "object/tilemap.hpp"
+#include "supertux/game_object.hpp"
+#include "supertux/gameconfig.hpp"
+#include "supertux/globals.hpp"
+#include "supertux/sector.hpp"
+#include "util/log.hpp"
+
+UndoManager::OptionValue::OptionValue() :
+  type(MN_LABEL),
+  string_value(),
+  float_value(0.0f),
+  int_value(0),
+  bool_value(false),
+  list_value(),
+  color_value()
+{
+}
+
+UndoManager::OptionValue
+UndoManager::OptionValue::read(const ObjectOption& option)
+{
+  OptionValue value;
+  value.type = option.type;
+  switch (option.type) {
+    case MN_TEXTFIELD:
+    case MN_SCRIPT:
+    case MN_FILE:
+      value.string_value = *(static_cast<std::string*>(option.option));
+      break;
+    case MN_NUMFIELD:
+      value.float_value = *(static_cast<float*>(option.option));
+      break;
+    case MN_INTFIELD:
+    case MN_STRINGSELECT:
+      value.int_value = *(static_cast<int*>(option.option));
+      break;
+    case MN_TOGGLE:
+      value.bool_value = *(static_cast<bool*>(option.option));
+      break;
+    case MN_BADGUYSELECT:
+      value.list_value = *(static_cast<std::vector<std::string>*>(option.option));
+      break;
+    case MN_COLOR:
+      value.color_value = *(static_cast<Color*>(option.option));
+      break;
+    default:
+      // no value behind the option
+      break;
+  }
+  return value;
+}
+
+void
+UndoManager::OptionValue::write(const ObjectOption& option) const
+{
+  assert(option.type == type);
+  switch (type) {
+    case MN_TEXTFIELD:
+    case MN_SCRIPT:
+    case MN_FILE:
+      *(static_cast<std::string*>(option.option)) = string_value;
+      break;
+    case MN_NUMFIELD:
+      *(static_cast<float*>(option.option)) = float_value;
+      break;
+    case MN_INTFIELD:
+    case MN_STRINGSELECT:
+      *(static_cast<int*>(option.option)) = int_value;
+      break;
+    case MN_TOGGLE:
+      *(static_cast<bool*>(option.option)) = bool_value;
+      break;
+    case MN_BADGUYSELECT:
+      *(static_cast<std::vector<std::string>*>(option.option)) = list_value;
+      break;
+    case MN_COLOR:
+      *(static_cast<Color*>(option.option)) = color_value;
+      break;
+    default:
+      break;
+  }
+}
+
+bool
+UndoManager::OptionValue::operator==(const OptionValue& other) const
+{
+  return
+    type == other.type &&
+    string_value == other.string_value &&
+    float_value == other.float_value &&
+    int_value == other.int_value &&
+    bool_value == other.bool_value &&
+    list_value == other.list_value &&
+    color_value == other.color_value;
+}
+
+size_t
+UndoManager::OptionValue::get_memory_usage() const
+{
+  size_t memory = sizeof(OptionValue) + string_value.capacity();
+  for (const auto& str : list_value) {
+    memory += sizeof(std::string) + str.capacity();
+  }
+  return memory;
+}
+
+UndoManager::UndoManager() :
+  m_undo_steps(),
+  m_redo_steps(),
+  m_memory(0),
+  m_action_depth(0),
+  m_action_sector(nullptr),
+  m_pending_tiles(),
+  m_pending_settings()
+{
+}
+
+void
+UndoManager::begin_action(Sector& sector)
+{
+  if (m_action_depth == 0) {
+    m_action_sector = &sector;
+  }
+  assert(m_action_sector == &sector);
+  m_action_depth += 1;
+}
+
+void
+UndoManager::end_action()
+{
+  assert(m_action_depth > 0);
+  m_action_depth -= 1;
+  if (m_action_depth > 0) {
+    return;
+  }
+
+  auto step = std::make_unique<Step>();
+  step->sector = m_action_sector;
+  for (auto& pending : m_pending_tiles) {
+    finish_tiles(*m_action_sector, pending, *step);
+  }
+  for (auto& pending : m_pending_settings) {
+    finish_settings(*m_action_sector, pending, *step);
+  }
+  m_pending_tiles.clear();
+  m_pending_settings.clear();
+  m_action_sector = nullptr;
+
+  if (step->tiles.empty() && step->settings.empty()) {
+    return;
+  }
+
+  push_undo_step(std::move(step));
+}
+
+void
+UndoManager::record_tiles(TileMap& tilemap, int x, int y, int count)
+{
+  if (m_action_depth == 0) {
+    return;
+  }
+
+  // only the part of the run that lies on the tilemap gets recorded
+  const int width = tilemap.get_width();
+  if (x < 0) {
+    count += x;
+    x = 0;
+  }
+  count = std::min(count, width - x);
+  if (count <= 0 || y < 0 || y >= tilemap.get_height()) {
+    return;
+  }
+
+  auto it = std::find_if(m_pending_tiles.begin(), m_pending_tiles.end(),
+                         [&tilemap](const PendingTiles& pending) {
+                           return pending.tilemap == tilemap.get_uid();
+                         });
+  if (it == m_pending_tiles.end()) {
+    m_pending_tiles.push_back({ tilemap.get_uid(), tilemap.get_width(), tilemap.get_height(), {} });
+    it = m_pending_tiles.end() - 1;
+  }
+
+  for (int i = 0; i < count; ++i) {
+    it->old_tiles.emplace_back(y * width + x + i, tilemap.get_tile_id(x + i, y));
+  }
+}
+
+void
+UndoManager::record_settings(GameObject& object)
+{
+  if (m_action_depth == 0) {
+    return;
+  }
+
+  for (const auto& pending : m_pending_settings) {
+    if (pending.object == object.get_uid()) {
+      // the values from the first record are the ones to go back to
+      return;
+    }
+  }
+
+  PendingSettings pending;
+  pending.object = object.get_uid();
+  auto settings = object.get_settings();
+  for (const auto& option : settings.options) {
+    pending.old_values.push_back(OptionValue::read(option));
+  }
+  m_pending_settings.push_back(std::move(pending));
+}
+
+void
+UndoManager::finish_tiles(Sector& sector, PendingTiles& pending, Step& step) const
+{
+  auto tilemap = sector.get_object_by_uid<TileMap>(pending.tilemap);
+  if (!tilemap ||
+      tilemap->get_width() != pending.width ||
+      tilemap->get_height() != pending.height) {
+    log_warning << "Tilemap changed its size while editing, the change can't be undone" << std::endl;
+    return;
+  }
+
+  // A tile recorded more than once keeps the value it had before
+  // its first change.
+  auto& records = pending.old_tiles;
+  std::stable_sort(records.begin(), records.end(),
+                   [](const std::pair<int, uint32_t>& lhs, const std::pair<int, uint32_t>& rhs) {
+                     return lhs.first < rhs.first;
+                   });
+
+  TileDelta delta;
+  delta.tilemap = pending.tilemap;
+  delta.width = pending.width;
+  delta.height = pending.height;
+
+  int last_index = -1;
+  for (const auto& record : records) {
+    if (record.first == last_index) {
+      continue;
+    }
+
+    const int x = record.first % pending.width;
+    const int y = record.first / pending.width;
+    const uint32_t new_tile = tilemap->get_tile_id(x, y);
+    if (new_tile != record.second) {
+      if (delta.runs.empty() ||
+          delta.runs.back().y != y ||
+          delta.runs.back().x + static_cast<int>(delta.runs.back().old_tiles.size()) != x) {
+        delta.runs.push_back({ x, y, {}, {} });
+      }
+      delta.runs.back().old_tiles.push_back(record.second);
+      delta.runs.back().new_tiles.push_back(new_tile);
+    }
+    last_index = record.first;
+  }
+
+  if (delta.runs.empty()) {
+    return;
+  }
+
+  step.memory += sizeof(TileDelta);
+  for (const auto& run : delta.runs) {
+    step.memory += sizeof(TileRun) + 2 * run.old_tiles.size() * sizeof(uint32_t);
+  }
+  step.tiles.push_back(std::move(delta));
+}
+
+void
+UndoManager::finish_settings(Sector& sector, PendingSettings& pending, Step& step) const
+{
+  auto object = sector.get_object_by_uid<GameObject>(pending.object);
+  if (!object) {
+    return;
+  }
+
+  auto settings = object->get_settings();
+  if (settings.options.size() != pending.old_values.size()) {
+    log_warning << "Options of '" << settings.name << "' changed while editing, the change can't be undone" << std::endl;
+    return;
+  }
+
+  SettingsDelta delta;
+  delta.object = pending.object;
+  for (size_t i = 0; i < settings.options.size(); ++i) {
+    auto new_value = OptionValue::read(settings.options[i]);
+    if (new_value == pending.old_values[i]) {
+      continue;
+    }
+
+    step.memory += sizeof(OptionChange) + pending.old_values[i].get_memory_usage() + new_value.get_memory_usage();
+    delta.changes.push_back({ i, std::move(pending.old_values[i]), std::move(new_value) });
+  }
+
+  if (delta.changes.empty()) {
+    return;
+  }
+
+  step.memory += sizeof(SettingsDelta);
+  step.settings.push_back(std::move(delta));
+}
+
+Sector*
+UndoManager::undo()
+{
+  assert(m_action_depth == 0);
+  if (m_undo_steps.empty()) {
+    return nullptr;
+  }
+
+  auto step = std::move(m_undo_steps.back());
+  m_undo_steps.pop_back();
+  apply(*step, true);
+
+  Sector* sector = step->sector;
+  m_redo_steps.push_back(std::move(step));
+  return sector;
+}
+
+Sector*
+UndoManager::redo()
+{
+  assert(m_action_depth == 0);
+  if (m_redo_steps.empty()) {
+    return nullptr;
+  }
+
+  auto step = std::move(m_redo_steps.back());
+  m_redo_steps.pop_back();
+  apply(*step, false);
+
+  Sector* sector = step->sector;
+  m_undo_steps.push_back(std::move(step));
+  return sector;
+}
+
+void
+UndoManager::clear()
+{
+  m_undo_steps.clear();
+  m_redo_steps.clear();
+  m_memory = 0;
+
+  // an open action still ends normally, but without a result
+  m_pending_tiles.clear();
+  m_pending_settings.clear();
+}
+
+void
+UndoManager::apply(const Step& step, bool undo) const
+{
+  for (const auto& delta : step.tiles) {
+    auto tilemap = step.sector->get_object_by_uid<TileMap>(delta.tilemap);
+    if (!tilemap) {
+      continue;
+    }
+    if (tilemap->get_width() != delta.width || tilemap->get_height() != delta.height) {
+      log_warning << "Tilemap was resized, can't restore its tiles" << std::endl;
+      continue;
+    }
+
+    tilemap->begin_changes();
+    for (const auto& run : delta.runs) {
+      tilemap->change_span(run.x, run.y, undo ? run.old_tiles : run.new_tiles);
+    }
+    tilemap->end_changes();
+  }
+
+  for (const auto& delta : step.settings) {
+    auto object = step.sector->get_object_by_uid<GameObject>(delta.object);
+    if (!object) {
+      continue;
+    }
+
+    auto settings = object->get_settings();
+    for (const auto& change : delta.changes) {
+      const auto& value = undo ? change.old_value : change.new_value;
+      if (change.index >= settings.options.size() ||
+          settings.options[change.index].type != value.type) {
+        continue;
+      }
+      value.write(settings.options[change.index]);
+    }
+    object->after_editor_set();
+  }
+}
+
+void
+UndoManager::push_undo_step(std::unique_ptr<Step> step)
+{
+  for (const auto& redo_step : m_redo_steps) {
+    m_memory -= redo_step->memory;
+  }
+  m_redo_steps.clear();
+
+  m_memory += step->memory;
+  m_undo_steps.push_back(std::move(step));
+  enforce_memory_limit();
+}
+
+void
+UndoManager::enforce_memory_limit()
+{
+  if (!g_config) {
+    return;
+  }
+  const size_t limit = static_cast<size_t>(std::max(g_config->editor_undo_memory, 0)) * 1024;
+
+  // the latest step is always kept, even when it is over the limit
+  while (m_memory > limit && m_undo_steps.size() > 1) {
+    m_memory -= m_undo_steps.front()->memory;
+    m_undo_steps.pop_front();
+  }
+}
+
+/* EOF */
@@ -0,0 +1,178 @@
+//  SuperTux
+//  Copyright (C) 2018 Ingo Ruhnke <grumbel@gmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_EDITOR_UNDO_MANAGER_HPP
+#define HEADER_SUPERTUX_EDITOR_UNDO_MANAGER_HPP
+
+#include <deque>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gui/menu_action.hpp"
+#include "util/uid.hpp"
+#include "video/color.hpp"
+
+class GameObject;
+class ObjectOption;
+class Sector;
+class TileMap;
+
+/** Undo history of the level editor. Instead of snapshots of the
+    level it keeps only what an edit changed: runs of tiles per
+    tilemap and the object options (see ObjectSettings) that got a
+    new value.
+
+    Changes are collected between begin_action() and end_action(),
+    everything recorded in between, like all the tiles painted
+    during one mouse drag, becomes a single undo step. The record
+    functions have to be called before the change is made, the new
+    values are read back when the action ends. */
+class UndoManager final
+{
+private:
+  struct OptionValue
+  {
+    OptionValue();
+
+    MenuItemKind type;
+    std::string string_value;
+    float float_value;
+    int int_value;
+    bool bool_value;
+    std::vector<std::string> list_value;
+    Color color_value;
+
+    static OptionValue read(const ObjectOption& option);
+    void write(const ObjectOption& option) const;
+    bool operator==(const OptionValue& other) const;
+    size_t get_memory_usage() const;
+  };
+
+  /** A horizontal run of tiles with their values before and after */
+  struct TileRun
+  {
+    int x;
+    int y;
+    std::vector<uint32_t> old_tiles;
+    std::vector<uint32_t> new_tiles;
+  };
+
+  struct TileDelta
+  {
+    UID tilemap;
+    int width;
+    int height;
+    std::vector<TileRun> runs;
+  };
+
+  struct OptionChange
+  {
+    size_t index;
+    OptionValue old_value;
+    OptionValue new_value;
+  };
+
+  struct SettingsDelta
+  {
+    UID object;
+    std::vector<OptionChange> changes;
+  };
+
+  struct Step
+  {
+    Step() : sector(), tiles(), settings(), memory(0) {}
+
+    Sector* sector;
+    std::vector<TileDelta> tiles;
+    std::vector<SettingsDelta> settings;
+    size_t memory;
+  };
+
+  /** tiles touched by the open action, as (index, old tile) in the
+      order they were recorded */
+  struct PendingTiles
+  {
+    UID tilemap;
+    int width;
+    int height;
+    std::vector<std::pair<int, uint32_t> > old_tiles;
+  };
+
+  struct PendingSettings
+  {
+    UID object;
+    std::vector<OptionValue> old_values;
+  };
+
+public:
+  UndoManager();
+
+  /** Starts collecting changes to sector, nested actions are joined
+      into the outermost one */
+  void begin_action(Sector& sector);
+  void end_action();
+  bool is_action_open() const { return m_action_depth > 0; }
+
+  /** Remembers count tiles starting at (x, y) before they get
+      changed, ignored while no action is open */
+  void record_tiles(TileMap& tilemap, int x, int y, int count);
+
+  /** Remembers the option values of object before they get edited,
+      ignored while no action is open */
+  void record_settings(GameObject& object);
+
+  /** Returns the sector that was changed or nullptr if there was
+      nothing to undo */
+  Sector* undo();
+  Sector* redo();
+
+  bool can_undo() const { return !m_undo_steps.empty(); }
+  bool can_redo() const { return !m_redo_steps.empty(); }
+
+  /** Forgets the whole history and the changes of an open action,
+      needed when a sector goes away */
+  void clear();
+
+  size_t get_memory_usage() const { return m_memory; }
+
+private:
+  void finish_tiles(Sector& sector, PendingTiles& pending, Step& step) const;
+  void finish_settings(Sector& sector, PendingSettings& pending, Step& step) const;
+  void apply(const Step& step, bool undo) const;
+  void push_undo_step(std::unique_ptr<Step> step);
+  void enforce_memory_limit();
+
+private:
+  std::deque<std::unique_ptr<Step> > m_undo_steps;
+  std::vector<std::unique_ptr<Step> > m_redo_steps;
+  size_t m_memory;
+
+  int m_action_depth;
+  Sector* m_action_sector;
+  std::vector<PendingTiles> m_pending_tiles;
+  std::vector<PendingSettings> m_pending_settings;
+
+private:
+  UndoManager(const UndoManager&) = delete;
+  UndoManager& operator=(const UndoManager&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -34,7 +34,7 @@ ItemBack::draw(DrawingContext& context, const Vector& pos, int menu_width, bool
                             Vector( pos.x + static_cast<float>(menu_width) / 2.0f,
                                     pos.y - static_cast<float>(int(Resources::normal_font->get_height()/2))),
                             ALIGN_CENTER, LAYER_GUI, active ? ColorScheme::Menu::active_color : get_color());
-  context.color().draw_surface(Resources::back,
+  context.color().draw_surface(*Resources::back,
                                Vector(pos.x + static_cast<float>(menu_width / 2) + text_width / 2.0f  + 16.0f,
                                       pos.y - 8.0f),
                                  LAYER_GUI);
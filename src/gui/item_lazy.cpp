@@ -1,5 +1,5 @@
 //  SuperTux
-//  Copyright (C) 2006 Matthias Braun <matze@braunis.de>
+//  Copyright (C) 2018 Ingo Ruhnke <grumbel@gmail.com>
 //
 //  This program is free software: you can redistribute it and/or modify
 //  it under the terms of the GNU General Public License as published by
@@ -14,35 +14,23 @@
 //  You should have received a copy of the GNU General Public License
 //  along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-#ifndef HEADER_SUPERTUX_OBJECT_RAINSPLASH_HPP
-#define HEADER_SUPERTUX_OBJECT_RAINSPLASH_HPP
+#include "gui/item_lazy.hpp"
 
-#include "math/vector.hpp"
-#include "sprite/sprite_manager.hpp"
-#include "supertux/game_object.hpp"
+#include <assert.h>
 
-class Player;
-
-class RainSplash final : public GameObject
+ItemLazy::ItemLazy(int id_, std::shared_ptr<const Menu::ItemSource> source) :
+  MenuItem("", id_),
+  m_source(std::move(source))
 {
-public:
-  RainSplash(const Vector& pos, bool vertical);
-  ~RainSplash();
-  virtual bool is_saveable() const override {
-    return false;
-  }
-
-protected:
-  virtual void hit(Player& );
-  virtual void update(float dt_sec) override;
-  virtual void draw(DrawingContext& context) override;
+}
 
-private:
-  SpritePtr sprite;
-  Vector position;
-  int frame;
-};
-
-#endif
+std::unique_ptr<MenuItem>
+ItemLazy::create() const
+{
+  auto item = (*m_source)(id);
+  assert(item);
+  assert(item->id == id);
+  return item;
+}
 
 /* EOF */
@@ -0,0 +1,44 @@
+//  SuperTux
+//  Copyright (C) 2018 Ingo Ruhnke <grumbel@gmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_GUI_ITEM_LAZY_HPP
+#define HEADER_SUPERTUX_GUI_ITEM_LAZY_HPP
+
+#include "gui/menu_item.hpp"
+
+/** Placeholder for a menu item that hasn't been created yet, Menu
+    replaces it with the result of its source once it is needed */
+class ItemLazy final : public MenuItem
+{
+public:
+  ItemLazy(int id, std::shared_ptr<const Menu::ItemSource> source);
+
+  std::unique_ptr<MenuItem> create() const;
+
+  /** The real width is unknown until the item is created */
+  virtual int get_width() const override { return 0; }
+
+private:
+  std::shared_ptr<const Menu::ItemSource> m_source;
+
+private:
+  ItemLazy(const ItemLazy&) = delete;
+  ItemLazy& operator=(const ItemLazy&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -41,11 +41,11 @@ ItemStringSelect::draw(DrawingContext& context, const Vector& pos, int menu_widt
                               ALIGN_LEFT, LAYER_GUI, active ? ColorScheme::Menu::active_color : get_color());
 
   // Draw right side
-  context.color().draw_surface(Resources::arrow_left,
+  context.color().draw_surface(*Resources::arrow_left,
                                Vector(pos.x + static_cast<float>(menu_width) - sel_width - 2.0f * roff - 8.0f,
                                       pos.y - 8.0f),
                                LAYER_GUI);
-  context.color().draw_surface(Resources::arrow_right,
+  context.color().draw_surface(*Resources::arrow_right,
                                Vector(pos.x + static_cast<float>(menu_width) - roff - 8.0f,
                                       pos.y - 8.0f),
                                LAYER_GUI);
@@ -46,12 +46,12 @@ ItemToggle::draw(DrawingContext& context, const Vector& pos, int menu_width, boo
                             ALIGN_LEFT, LAYER_GUI, active ? ColorScheme::Menu::active_color : get_color());
 
   if (m_get_func()) {
-    context.color().draw_surface(Resources::checkbox_checked,
+    context.color().draw_surface(*Resources::checkbox_checked,
                                  Vector(pos.x + static_cast<float>(menu_width) - 16.0f - static_cast<float>(Resources::checkbox->get_width()),
                                         pos.y - 8.0f),
                                  LAYER_GUI + 1);
   } else {
-    context.color().draw_surface(Resources::checkbox,
+    context.color().draw_surface(*Resources::checkbox,
                                  Vector(pos.x + static_cast<float>(menu_width) - 16.0f - static_cast<float>(Resources::checkbox->get_width()),
                                         pos.y - 8.0f),
                                  LAYER_GUI + 1);
@@ -16,6 +16,9 @@
 
 #include "gui/menu.hpp"
 
+#include <algorithm>
+#include <math.h>
+
 #include "control/input_manager.hpp"
 #include "gui/item_action.hpp"
 #include "gui/item_back.hpp"
@@ -30,6 +33,7 @@
 #include "gui/item_inactive.hpp"
 #include "gui/item_intfield.hpp"
 #include "gui/item_label.hpp"
+#include "gui/item_lazy.hpp"
 #include "gui/item_numfield.hpp"
 #include "gui/item_script.hpp"
 #include "gui/item_script_line.hpp"
@@ -91,7 +95,13 @@ Menu::add_item(std::unique_ptr<MenuItem> new_item)
     active_item = static_cast<int>(items.size()) - 1;
   }
 
-  calculate_width();
+  // only the new item needs measuring, unless the list was cleared
+  // behind our back
+  const float w = static_cast<float>(item.get_width());
+  if (items.size() == 1 || w > menu_width)
+  {
+    menu_width = w;
+  }
 
   return item;
 }
@@ -111,7 +121,7 @@ Menu::add_item(std::unique_ptr<MenuItem> new_item, int pos_)
     active_item++;
   }
 
-  calculate_width();
+  menu_width = std::max(menu_width, static_cast<float>(item.get_width()));
 
   return item;
 }
@@ -132,7 +142,7 @@ Menu::delete_item(int pos_)
         --active_item;
       else
         active_item = int(items.size())-1;
-    } while (items[active_item]->skippable());
+    } while (get_item(active_item).skippable());
   }
 }
 
@@ -315,11 +325,40 @@ Menu::add_badguy_select(const std::string& text, std::vector<std::string>* badgu
   return *item_ptr;
 }
 
+void
+Menu::add_lazy_items(const std::vector<int>& ids, ItemSource source)
+{
+  auto shared_source = std::make_shared<const ItemSource>(std::move(source));
+
+  items.reserve(items.size() + ids.size());
+  for (int id : ids)
+  {
+    items.push_back(std::make_unique<ItemLazy>(id, shared_source));
+    if (active_item == -1)
+    {
+      active_item = static_cast<int>(items.size()) - 1;
+    }
+  }
+}
+
+MenuItem&
+Menu::get_item(int index)
+{
+  auto& item = items[index];
+  if (auto lazy = dynamic_cast<ItemLazy*>(item.get()))
+  {
+    item = lazy->create();
+    menu_width = std::max(menu_width, static_cast<float>(item->get_width()));
+  }
+  return *item;
+}
+
 void
 Menu::clear()
 {
   items.clear();
   active_item = -1;
+  menu_width = 0;
 }
 
 void
@@ -418,7 +457,7 @@ Menu::process_action(const MenuAction& menuaction)
           --active_item;
         else
           active_item = int(items.size())-1;
-      } while (items[active_item]->skippable()
+      } while (get_item(active_item).skippable()
                && (active_item != last_active_item));
       break;
 
@@ -428,7 +467,7 @@ Menu::process_action(const MenuAction& menuaction)
           ++active_item;
         else
           active_item = 0;
-      } while (items[active_item]->skippable()
+      } while (get_item(active_item).skippable()
                && (active_item != last_active_item));
       break;
 
@@ -443,17 +482,18 @@ Menu::process_action(const MenuAction& menuaction)
       break;
   }
 
-  if (items[active_item]->no_other_action()) {
-    items[active_item]->process_action(menuaction);
+  MenuItem& item = get_item(active_item);
+  if (item.no_other_action()) {
+    item.process_action(menuaction);
     return;
   }
 
-  items[active_item]->process_action(menuaction);
-  if(items[active_item]->changes_width()) {
+  item.process_action(menuaction);
+  if(item.changes_width()) {
     calculate_width();
   }
   if(menuaction == MENU_ACTION_HIT) {
-    menu_action(*items[active_item]);
+    menu_action(item);
   }
 }
 
@@ -463,7 +503,7 @@ Menu::draw_item(DrawingContext& context, int index)
   float menu_height = get_height();
   float menu_width_ = get_width();
 
-  MenuItem* pitem = items[index].get();
+  MenuItem* pitem = &get_item(index);
 
   float x_pos       = pos.x - menu_width_/2;
   float y_pos       = pos.y + 24.0f * static_cast<float>(index) - menu_height / 2.0f + 12.0f;
@@ -523,10 +563,11 @@ Menu::on_window_resize()
 void
 Menu::draw(DrawingContext& context)
 {
-  if (!items[active_item]->help.empty())
+  const std::string& help = get_item(active_item).help;
+  if (!help.empty())
   {
-    int text_width  = static_cast<int>(Resources::normal_font->get_text_width(items[active_item]->help));
-    int text_height = static_cast<int>(Resources::normal_font->get_text_height(items[active_item]->help));
+    int text_width  = static_cast<int>(Resources::normal_font->get_text_width(help));
+    int text_height = static_cast<int>(Resources::normal_font->get_text_height(help));
 
     Rectf text_rect(pos.x - static_cast<float>(text_width) / 2.0f - 8.0f,
                     static_cast<float>(SCREEN_HEIGHT) - 48.0f - static_cast<float>(text_height) / 2.0f - 4.0f,
@@ -544,12 +585,25 @@ Menu::draw(DrawingContext& context)
                                        16.0f,
                                        LAYER_GUI-10);
 
-    context.color().draw_text(Resources::normal_font, items[active_item]->help,
+    context.color().draw_text(Resources::normal_font, help,
                               Vector(pos.x, static_cast<float>(SCREEN_HEIGHT) - 48.0f - static_cast<float>(text_height) / 2.0f),
                               ALIGN_CENTER, LAYER_GUI);
   }
 
-  for(unsigned int i = 0; i < items.size(); ++i)
+  // only the rows on the screen are drawn, one extra row on each side
+  // covers the highlight of the active item
+  const float top = pos.y - get_height() / 2.0f;
+  const int first = std::max(static_cast<int>(floorf(-top / 24.0f)) - 1, 0);
+  const int last = std::min(static_cast<int>(ceilf((static_cast<float>(SCREEN_HEIGHT) - top) / 24.0f)) + 1,
+                            static_cast<int>(items.size()));
+
+  // create lazy items before drawing, so that all rows agree on the width
+  for(int i = first; i < last; ++i)
+  {
+    get_item(i);
+  }
+
+  for(int i = first; i < last; ++i)
   {
     draw_item(context, i);
   }
@@ -558,11 +612,11 @@ Menu::draw(DrawingContext& context)
 MenuItem&
 Menu::get_item_by_id(int id)
 {
-  for (const auto& item : items)
+  for (size_t i = 0; i < items.size(); ++i)
   {
-    if (item->id == id)
+    if (items[i]->id == id)
     {
-      return *item;
+      return get_item(static_cast<int>(i));
     }
   }
 
@@ -591,12 +645,12 @@ int Menu::get_active_item_id() const
 void
 Menu::event(const SDL_Event& ev)
 {
-  items[active_item]->event(ev);
+  get_item(active_item).event(ev);
   switch(ev.type) {
     case SDL_KEYDOWN:
     case SDL_TEXTINPUT:
       if(((ev.type == SDL_KEYDOWN && ev.key.keysym.sym == SDLK_BACKSPACE) ||
-         ev.type == SDL_TEXTINPUT) && items[active_item]->changes_width())
+         ev.type == SDL_TEXTINPUT) && get_item(active_item).changes_width())
       {
         // Changed item value? Let's recalculate width:
         calculate_width();
@@ -633,7 +687,7 @@ Menu::event(const SDL_Event& ev)
           = static_cast<int> ((y - (pos.y - get_height()/2)) / 24);
 
         /* only change the mouse focus to a selectable item */
-        if (!items[new_active_item]->skippable())
+        if (!get_item(new_active_item).skippable())
           active_item = new_active_item;
 
         if(MouseCursor::current())
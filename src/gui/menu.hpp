@@ -20,6 +20,7 @@
 #include <functional>
 #include <memory>
 #include <SDL.h>
+#include <vector>
 
 #include "gui/menu_action.hpp"
 #include "math/vector.hpp"
@@ -49,6 +50,10 @@ class MenuItem;
 
 class Menu
 {
+public:
+  /** Creates the menu item with the given id */
+  using ItemSource = std::function<std::unique_ptr<MenuItem>(int id)>;
+
 public:
   Menu();
   virtual ~Menu();
@@ -78,6 +83,12 @@ public:
   ItemColorDisplay& add_color_display(Color* color, int id = -1);
   ItemColorChannel& add_color_channel(float* input, Color channel, int id = -1);
 
+  /** Adds one row per id, the items are only created through source
+      once they get drawn or selected, so that long lists don't have
+      to be built up front. The items have to be selectable and the
+      menu grows wider as wider items get created. */
+  void add_lazy_items(const std::vector<int>& ids, ItemSource source);
+
   virtual void menu_action(MenuItem& item) = 0;
 
   /**
@@ -94,10 +105,8 @@ public:
   /** Remove all entries from the menu */
   void clear();
 
-  MenuItem& get_item(int index)
-  {
-    return *(items[index]);
-  }
+  /** Returns the item at index, creating it if it is still lazy */
+  MenuItem& get_item(int index);
 
   MenuItem& get_item_by_id(int id);
   const MenuItem& get_item_by_id(int id) const;
@@ -75,13 +75,13 @@ void MouseCursor::draw(DrawingContext& context)
       tmp_state = MC_CLICK;
     }
 
-    context.color().draw_surface(m_cursor[static_cast<int>(tmp_state)],
+    context.color().draw_surface(*m_cursor[static_cast<int>(tmp_state)],
                                  Vector(static_cast<float>(x - m_mid_x),
                                         static_cast<float>(y - m_mid_y)),
                                  LAYER_GUI + 100);
 
     if (m_icon) {
-      context.color().draw_surface(m_icon,
+      context.color().draw_surface(*m_icon,
                                    Vector(static_cast<float>(x - m_mid_x),
                                           static_cast<float>(y - m_mid_y - m_icon->get_height())),
                                    LAYER_GUI + 100);
@@ -280,7 +280,7 @@ Background::draw_image(DrawingContext& context, const Vector& pos__)
                          pos_.y - static_cast<float>(context.get_height()) / 2.0f),
                   Sizef(static_cast<float>(context.get_width()),
                         static_cast<float>(context.get_height())));
-    canvas.draw_surface_scaled(m_image, dstrect, m_layer);
+    canvas.draw_surface_scaled(*m_image, dstrect, m_layer);
   }
   else
   {
@@ -291,7 +291,7 @@ Background::draw_image(DrawingContext& context, const Vector& pos__)
         {
           Vector p(pos_.x - parallax_image_size.width / 2.0f,
                    pos_.y + static_cast<float>(y) * img_h - img_h_2);
-          canvas.draw_surface(m_image, p, m_layer);
+          canvas.draw_surface(*m_image, p, m_layer);
         }
         break;
 
@@ -300,7 +300,7 @@ Background::draw_image(DrawingContext& context, const Vector& pos__)
         {
           Vector p(pos_.x + parallax_image_size.width / 2.0f - img_w,
                    pos_.y + static_cast<float>(y) * img_h - img_h_2);
-          canvas.draw_surface(m_image, p, m_layer);
+          canvas.draw_surface(*m_image, p, m_layer);
         }
         break;
 
@@ -309,7 +309,7 @@ Background::draw_image(DrawingContext& context, const Vector& pos__)
         {
           Vector p(pos_.x + static_cast<float>(x) * img_w - img_w_2,
                    pos_.y - parallax_image_size.height / 2.0f);
-          canvas.draw_surface(m_image, p, m_layer);
+          canvas.draw_surface(*m_image, p, m_layer);
         }
         break;
 
@@ -318,7 +318,7 @@ Background::draw_image(DrawingContext& context, const Vector& pos__)
         {
           Vector p(pos_.x + static_cast<float>(x) * img_w - img_w_2,
                    pos_.y - img_h + parallax_image_size.height / 2.0f);
-          canvas.draw_surface(m_image, p, m_layer);
+          canvas.draw_surface(*m_image, p, m_layer);
         }
         break;
 
@@ -331,15 +331,15 @@ Background::draw_image(DrawingContext& context, const Vector& pos__)
 
             if (m_image_top.get() != nullptr && (y < 0))
             {
-              canvas.draw_surface(m_image_top, p, m_layer);
+              canvas.draw_surface(*m_image_top, p, m_layer);
             }
             else if (m_image_bottom.get() != nullptr && (y > 0))
             {
-              canvas.draw_surface(m_image_bottom, p, m_layer);
+              canvas.draw_surface(*m_image_bottom, p, m_layer);
             }
             else
             {
-              canvas.draw_surface(m_image, p, m_layer);
+              canvas.draw_surface(*m_image, p, m_layer);
             }
           }
         break;
@@ -47,6 +47,7 @@ public:
   { return m_speed; }
 
   virtual void update(float dt_sec) override;
+  virtual bool is_update_parallel_safe() const override { return true; }
 
   virtual void draw(DrawingContext& context) override;
   void draw_image(DrawingContext& context, const Vector& pos);
@@ -31,6 +31,8 @@ public:
 
   void init();
   virtual void update(float dt_sec) override;
+  virtual bool is_update_parallel_safe() const override { return true; }
+  virtual size_t get_update_cost() const override { return particles.size(); }
 
   virtual std::string type() const
   { return "CloudParticleSystem"; }
@@ -73,36 +73,32 @@ Explosion::explode()
 
   if (push) {
     Vector center = m_bbox.get_middle ();
-    auto near_objects = Sector::get().get_nearby_objects (center, 10.0 * 32.0);
-
-    for(auto& obj: near_objects) {
-      Vector obj_vector = obj->get_bbox ().get_middle ();
-      Vector direction = obj_vector - center;
-      float distance = direction.norm ();
-
-      /* If the distance is very small, for example because "obj" is the badguy
-       * causing the explosion, skip this object. */
-      if (distance <= 1.0)
-        continue;
-
-      /* The force decreases with the distance squared. In the distance of one
-       * tile (32 pixels) you will have a speed increase of 150 pixels/s. */
-      float force = 150.0f * 32.0f * 32.0f / (distance * distance);
-      if (force > 200.0)
-        force = 200.0;
-
-      Vector add_speed = direction.unit () * force;
-
-      auto player = dynamic_cast<Player *> (obj);
-      if (player) {
-        player->add_velocity (add_speed);
-      }
-
-      auto badguy = dynamic_cast<WalkingBadguy *> (obj);
-      if (badguy && badguy->is_active()) {
-        badguy->add_velocity (add_speed);
-      }
-    } /* for (i = 0 ... near_objects) */
+    Sector::get().for_each_nearby_object(center, 10.0f * 32.0f,
+                                         (1 << COLGROUP_MOVING) | (1 << COLGROUP_MOVING_STATIC),
+                                         [&center](MovingObject& obj, float distance) {
+                                           /* If the distance is very small, for example because "obj" is the badguy
+                                            * causing the explosion, skip this object. */
+                                           if (distance <= 1.0)
+                                             return;
+
+                                           /* The force decreases with the distance squared. In the distance of one
+                                            * tile (32 pixels) you will have a speed increase of 150 pixels/s. */
+                                           float force = 150.0f * 32.0f * 32.0f / (distance * distance);
+                                           if (force > 200.0)
+                                             force = 200.0;
+
+                                           Vector add_speed = (obj.get_bbox().get_middle() - center).unit() * force;
+
+                                           auto player = dynamic_cast<Player *> (&obj);
+                                           if (player) {
+                                             player->add_velocity (add_speed);
+                                           }
+
+                                           auto badguy = dynamic_cast<WalkingBadguy *> (&obj);
+                                           if (badguy && badguy->is_active()) {
+                                             badguy->add_velocity (add_speed);
+                                           }
+                                         });
   } /* if (push) */
 }
 
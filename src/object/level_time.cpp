@@ -86,7 +86,7 @@ LevelTime::draw(DrawingContext& context)
     if (time_surface)
     {
       float all_width = static_cast<float>(time_surface->get_width()) + Resources::normal_font->get_text_width(time_text);
-      context.color().draw_surface(time_surface,
+      context.color().draw_surface(*time_surface,
                                    Vector((static_cast<float>(context.get_width()) - all_width) / 2.0f,
                                           BORDER_Y + 1),
                                    LAYER_FOREGROUND1);
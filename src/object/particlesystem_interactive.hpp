@@ -19,8 +19,6 @@
 
 #include "object/particlesystem.hpp"
 
-class Vector;
-
 /**
  * This is an alternative class for particle systems. It is responsible for storing a
  * set of particles with each having an x- and y-coordinate the number of the
@@ -43,10 +41,6 @@ public:
   {
     return _("Interactive particle system");
   }
-
-protected:
-  int collision(Particle* particle, const Vector& movement);
-
 };
 
 #endif
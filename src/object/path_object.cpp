@@ -80,7 +80,7 @@ PathObject::init_path_empty()
 }
 
 Path*
-PathObject::get_path()
+PathObject::get_path() const
 {
   if (!d_sector) return nullptr;
 
@@ -38,7 +38,7 @@ public:
   void init_path_empty();
 
   /** Returns this object's path */
-  Path* get_path();
+  Path* get_path() const;
   std::string get_path_ref() const;
 
   /** Returns this object's path walker */
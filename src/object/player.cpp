@@ -1164,7 +1164,7 @@ Player::draw(DrawingContext& context)
     float px = m_bbox.p1.x + (m_bbox.p2.x - m_bbox.p1.x - static_cast<float>(m_airarrow.get()->get_width())) / 2.0f;
     float py = Sector::get().m_camera->get_translation().y;
     py += std::min(((py - (m_bbox.p2.y + 16)) / 4), 16.0f);
-    context.color().draw_surface(m_airarrow, Vector(px, py), LAYER_HUD - 1);
+    context.color().draw_surface(*m_airarrow, Vector(px, py), LAYER_HUD - 1);
   }
 
   std::string sa_prefix = "";
@@ -29,6 +29,7 @@ public:
   virtual ~PulsingLight();
 
   virtual void update(float dt_sec) override;
+  virtual bool is_update_parallel_safe() const override { return true; }
   virtual void draw(DrawingContext& context) override;
 
 protected:
@@ -16,22 +16,42 @@
 
 #include "object/rain_particle_system.hpp"
 
+#include <algorithm>
 #include <assert.h>
 
 #include "math/random.hpp"
 #include "object/camera.hpp"
-#include "object/rainsplash.hpp"
+#include "sprite/sprite.hpp"
+#include "sprite/sprite_manager.hpp"
 #include "supertux/sector.hpp"
+#include "supertux/tile.hpp"
+#include "video/drawing_context.hpp"
 #include "video/surface.hpp"
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
 
-RainParticleSystem::RainParticleSystem()
+namespace {
+
+/** maximum number of splashes visible at once, the oldest splash gets
+    recycled when the pool is exhausted */
+const size_t MAX_SPLASHES = 128;
+
+} // namespace
+
+RainParticleSystem::RainParticleSystem() :
+  m_splash_sprite(),
+  m_splashes(MAX_SPLASHES),
+  m_next_splash(0),
+  m_probes()
 {
   init();
 }
 
-RainParticleSystem::RainParticleSystem(const ReaderMapping& reader)
+RainParticleSystem::RainParticleSystem(const ReaderMapping& reader) :
+  m_splash_sprite(),
+  m_splashes(MAX_SPLASHES),
+  m_next_splash(0),
+  m_probes()
 {
   init();
   parse(reader);
@@ -46,6 +66,8 @@ void RainParticleSystem::init()
   rainimages[0] = Surface::from_file("images/objects/particles/rain0.png");
   rainimages[1] = Surface::from_file("images/objects/particles/rain1.png");
 
+  m_splash_sprite = SpriteManager::current()->create("images/objects/particles/rainsplash.sprite");
+
   virtual_width = static_cast<float>(SCREEN_WIDTH) * 2.0f;
 
   // create some random raindrops
@@ -62,6 +84,8 @@ void RainParticleSystem::init()
 
     particles.push_back(std::move(particle));
   }
+
+  m_probes.reserve(particles.size());
 }
 
 void RainParticleSystem::update(float dt_sec)
@@ -69,42 +93,83 @@ void RainParticleSystem::update(float dt_sec)
   if(!enabled)
     return;
 
+  // a splash plays its animation once
+  const float splash_lifetime = static_cast<float>(m_splash_sprite->get_frames()) / m_splash_sprite->get_fps();
+  for(auto& splash : m_splashes) {
+    if(splash.age < 0.0f)
+      continue;
+
+    splash.age += dt_sec;
+    if(splash.age >= splash_lifetime)
+      splash.age = -1.0f;
+  }
+
+  float abs_x = Sector::get().m_camera->get_translation().x;
+  float abs_y = Sector::get().m_camera->get_translation().y;
+
+  // move all drops first and then resolve their collisions with the
+  // tilemaps in one batch, probing the lower left corner of each drop
+  m_probes.clear();
   for(auto& it : particles) {
     auto particle = dynamic_cast<RainParticle*>(it.get());
     assert(particle);
 
     float movement = particle->speed * dt_sec * Sector::get().get_gravity();
-    float abs_x = Sector::get().m_camera->get_translation().x;
-    float abs_y = Sector::get().m_camera->get_translation().y;
+    m_probes.emplace_back(particle->pos + Vector(0, 32), Vector(-movement, movement));
     particle->pos.y += movement;
     particle->pos.x -= movement;
-    int col = collision(particle, Vector(-movement, movement));
-    if ((particle->pos.y > static_cast<float>(SCREEN_HEIGHT) + abs_y) || (col >= 0)) {
-      //Create rainsplash
-      if ((particle->pos.y <= static_cast<float>(SCREEN_HEIGHT) + abs_y) && (col >= 1)){
-        bool vertical = (col == 2);
-        if (!vertical) { //check if collision happened from above
-          int splash_x, splash_y; // move outside if statement when
-                                  // uncommenting the else statement below.
-          splash_x = int(particle->pos.x);
-          splash_y = int(particle->pos.y) - (int(particle->pos.y) % 32) + 32;
-          Sector::get().add<RainSplash>(Vector(static_cast<float>(splash_x), static_cast<float>(splash_y)),
-                                             vertical);
-        }
-        // Uncomment the following to display vertical splashes, too
-        /* else {
-           splash_x = int(particle->pos.x) - (int(particle->pos.x) % 32) + 32;
-           splash_y = int(particle->pos.y);
-           Sector::get().add<RainSplash>(Vector(splash_x, splash_y),vertical);
-           } */
-      }
-      int new_x = graphicsRandom.rand(int(virtual_width)) + int(abs_x);
-      int new_y = 0;
-      //FIXME: Don't move particles over solid tiles
-      particle->pos.x = static_cast<float>(new_x);
-      particle->pos.y = static_cast<float>(new_y);
+  }
+
+  Sector::get().probe_tiles(m_probes);
+
+  for(size_t i = 0; i < particles.size(); ++i) {
+    auto& particle = particles[i];
+    const auto& probe = m_probes[i];
+
+    bool below_screen = particle->pos.y > static_cast<float>(SCREEN_HEIGHT) + abs_y;
+    if (!below_screen && !probe.attributes)
+      continue;
+
+    // no splash for water tiles, and only show splashes from above
+    if (!below_screen && !(probe.attributes & Tile::WATER) && !probe.from_side) {
+      int splash_x = int(particle->pos.x);
+      int splash_y = int(particle->pos.y) - (int(particle->pos.y) % 32) + 32;
+      add_splash(Vector(static_cast<float>(splash_x), static_cast<float>(splash_y)));
     }
+
+    int new_x = graphicsRandom.rand(int(virtual_width)) + int(abs_x);
+    int new_y = 0;
+    //FIXME: Don't move particles over solid tiles
+    particle->pos.x = static_cast<float>(new_x);
+    particle->pos.y = static_cast<float>(new_y);
   }
 }
 
+void RainParticleSystem::draw(DrawingContext& context)
+{
+  ParticleSystem_Interactive::draw(context);
+
+  if(!enabled)
+    return;
+
+  const Vector offset(m_splash_sprite->get_current_hitbox_x_offset(),
+                      m_splash_sprite->get_current_hitbox_y_offset());
+  for(const auto& splash : m_splashes) {
+    if(splash.age < 0.0f)
+      continue;
+
+    int frame = std::min(static_cast<int>(splash.age * m_splash_sprite->get_fps()),
+                         m_splash_sprite->get_frames() - 1);
+    context.color().draw_surface(m_splash_sprite->get_frame_surface(frame), splash.pos - offset, LAYER_OBJECTS);
+  }
+}
+
+void RainParticleSystem::add_splash(const Vector& pos)
+{
+  Splash& splash = m_splashes[m_next_splash];
+  splash.pos = pos;
+  splash.age = 0.0f;
+  m_next_splash = (m_next_splash + 1) % m_splashes.size();
+}
+
 /* EOF */
@@ -18,6 +18,8 @@
 #define HEADER_SUPERTUX_OBJECT_RAIN_PARTICLE_SYSTEM_HPP
 
 #include "object/particlesystem_interactive.hpp"
+#include "sprite/sprite_ptr.hpp"
+#include "supertux/collision.hpp"
 #include "video/surface_ptr.hpp"
 
 class RainParticleSystem final : public ParticleSystem_Interactive
@@ -29,6 +31,7 @@ public:
 
   void init();
   virtual void update(float dt_sec) override;
+  virtual void draw(DrawingContext& context) override;
 
   std::string type() const
   { return "RainParticleSystem"; }
@@ -43,6 +46,9 @@ public:
     return "images/engine/editor/rain.png";
   }
 
+private:
+  void add_splash(const Vector& pos);
+
 private:
   class RainParticle : public Particle
   {
@@ -54,7 +60,31 @@ private:
     {}
   };
 
+  /** A splash left behind by a raindrop hitting the ground. Splashes
+      live in a fixed size pool inside the particle system instead of
+      being added to the sector as GameObjects. */
+  struct Splash
+  {
+    Splash() :
+      pos(),
+      age(-1.0f)
+    {}
+
+    Vector pos;
+    /** seconds since the splash started, negative if the slot is free */
+    float age;
+  };
+
   SurfacePtr rainimages[2];
+  /** only used for its images and frame rate, the splashes are drawn
+      from it without a Sprite each */
+  SpritePtr m_splash_sprite;
+
+  std::vector<Splash> m_splashes;
+  size_t m_next_splash;
+
+  /** reused every frame to avoid reallocating the probe batch */
+  std::vector<collision::TileProbe> m_probes;
 
 private:
   RainParticleSystem(const RainParticleSystem&) = delete;
@@ -16,10 +16,14 @@
 
 #include "object/tilemap.hpp"
 
+#include <algorithm>
+#include <map>
 #include <tuple>
 #include <cmath>
 
 #include "editor/editor.hpp"
+#include "object/tilemap_lights.hpp"
+#include "object/tilemap_listener.hpp"
 #include "supertux/globals.hpp"
 #include "supertux/sector.hpp"
 #include "supertux/tile.hpp"
@@ -30,6 +34,24 @@
 #include "video/drawing_context.hpp"
 #include "video/surface.hpp"
 
+namespace {
+
+/** number of changes TileMap::get_changed_area() can look back */
+const size_t CHANGE_LOG_SIZE = 16;
+
+Rect unite(const Rect& lhs, const Rect& rhs)
+{
+  if (lhs.empty())
+    return rhs;
+  if (rhs.empty())
+    return lhs;
+
+  return Rect(std::min(lhs.left, rhs.left), std::min(lhs.top, rhs.top),
+              std::max(lhs.right, rhs.right), std::max(lhs.bottom, rhs.bottom));
+}
+
+} // namespace
+
 TileMap::TileMap(const TileSet *new_tileset) :
   ExposedObject<TileMap, scripting::TileMap>(this),
   PathObject(),
@@ -58,7 +80,14 @@ TileMap::TileMap(const TileSet *new_tileset) :
   m_new_size_y(0),
   m_new_offset_x(0),
   m_new_offset_y(0),
-  m_add_path(false)
+  m_add_path(false),
+  m_listeners(),
+  m_change_depth(0),
+  m_changes_pending(false),
+  m_pending_area(),
+  m_version(0),
+  m_change_log(),
+  m_lights()
 {
 }
 
@@ -91,7 +120,14 @@ TileMap::TileMap(const TileSet *tileset_, const ReaderMapping& reader) :
   m_new_size_y(0),
   m_new_offset_x(0),
   m_new_offset_y(0),
-  m_add_path(false)
+  m_add_path(false),
+  m_listeners(),
+  m_change_depth(0),
+  m_changes_pending(false),
+  m_pending_area(),
+  m_version(0),
+  m_change_log(),
+  m_lights()
 {
   assert(m_tileset);
 
@@ -204,7 +240,7 @@ TileMap::save(Writer& writer) {
   if (get_path()) {
     writer.write("path-ref", get_path_ref());
   }
-  writer.write("tiles", m_tiles);
+  writer.write("tiles", m_tiles, m_width);
 }
 
 ObjectSettings
@@ -247,6 +283,8 @@ TileMap::get_settings() {
 void
 TileMap::after_editor_set()
 {
+  update_effective_solid();
+
   if ((m_new_size_x != m_width || m_new_size_y != m_height ||
       m_new_offset_x || m_new_offset_y) &&
       m_new_size_x > 0 && m_new_size_y > 0) {
@@ -305,11 +343,34 @@ TileMap::update(float dt_sec)
       set_offset(Vector(0, 0));
     }
   }
+
+  if (m_lights) {
+    m_lights->update(dt_sec);
+  }
+}
+
+bool
+TileMap::is_update_parallel_safe() const
+{
+  // solid tilemaps carry the objects on them along, unordered paths
+  // pick their next node with gameRandom
+  if (m_real_solid)
+    return false;
+
+  if (!get_walker())
+    return true;
+
+  auto path = get_path();
+  return !path || path->m_mode != WalkMode::UNORDERED;
 }
 
 void
 TileMap::draw(DrawingContext& context)
 {
+  if (m_lights) {
+    m_lights->draw(context, *this);
+  }
+
   // skip draw if current opacity is 0.0
   if (m_current_alpha == 0.0) return;
 
@@ -342,9 +403,12 @@ TileMap::draw(DrawingContext& context)
   Vector pos;
   int tx, ty;
 
-  std::unordered_map<SurfacePtr,
-                     std::tuple<std::vector<Rectf>,
-                                std::vector<Rectf>>> batches;
+  // tiles cut from the same image share a texture and can go into the
+  // same batch, no matter which Surface they come from
+  std::map<std::tuple<const Texture*, const Texture*, Flip>,
+           std::tuple<const Surface*,
+                      std::vector<Rectf>,
+                      std::vector<Rectf>>> batches;
 
   for(pos.x = start.x, tx = t_draw_rect.left; tx < t_draw_rect.right; pos.x += 32, ++tx) {
     for(pos.y = start.y, ty = t_draw_rect.top; ty < t_draw_rect.bottom; pos.y += 32, ++ty) {
@@ -355,14 +419,18 @@ TileMap::draw(DrawingContext& context)
       if (m_tiles[index] == 0) continue;
       const Tile& tile = m_tileset->get(m_tiles[index]);
 
-      const SurfacePtr& surface = tile.get_current_surface();
+      const Surface* surface = tile.get_current_surface();
 
       if (surface)
       {
-        std::get<0>(batches[surface]).push_back(Rectf(surface->get_region())),
-        std::get<1>(batches[surface]).push_back(Rectf(pos,
-                                                      Sizef(static_cast<float>(surface->get_width()),
-                                                            static_cast<float>(surface->get_height()))));
+        auto& batch = batches[std::make_tuple(surface->get_texture().get(),
+                                              surface->get_displacement_texture().get(),
+                                              surface->get_flip())];
+        std::get<0>(batch) = surface;
+        std::get<1>(batch).push_back(Rectf(surface->get_region()));
+        std::get<2>(batch).push_back(Rectf(pos,
+                                           Sizef(static_cast<float>(surface->get_width()),
+                                                 static_cast<float>(surface->get_height()))));
       }
     }
   }
@@ -371,13 +439,11 @@ TileMap::draw(DrawingContext& context)
 
   for(const auto& it : batches)
   {
-    const SurfacePtr& surface = it.first;
-    if (!surface) continue;
+    const Surface* surface = std::get<0>(it.second);
+    const std::vector<Rectf>& srcrects = std::get<1>(it.second);
+    const std::vector<Rectf>& dstrects = std::get<2>(it.second);
 
-    const std::vector<Rectf>& srcrects = std::get<0>(it.second);
-    const std::vector<Rectf>& dstrects = std::get<1>(it.second);
-
-    canvas.draw_surface_batch(surface, srcrects, dstrects, m_current_tint, m_z_pos);
+    canvas.draw_surface_batch(*surface, srcrects, dstrects, m_current_tint, m_z_pos);
   }
 
   context.pop_transform();
@@ -427,6 +493,8 @@ TileMap::set(int newwidth, int newheight, const std::vector<unsigned int>&newt,
   // make sure all tiles are loaded
   for(const auto& tile : m_tiles)
     m_tileset->get(tile);
+
+  notify_tiles_changed();
 }
 
 void
@@ -476,6 +544,8 @@ TileMap::resize(int new_width, int new_height, int fill_id,
       }
     }
   }
+
+  notify_tiles_changed();
 }
 
 void TileMap::resize(const Size& newsize, const Size& resize_offset) {
@@ -520,6 +590,32 @@ TileMap::get_tile(int x, int y) const
   return m_tileset->get(id);
 }
 
+uint32_t
+TileMap::get_tile_attributes(int x, int y) const
+{
+  return m_tileset->get_attributes(get_tile_id(x, y));
+}
+
+int
+TileMap::get_tile_data(int x, int y) const
+{
+  return m_tileset->get_data(get_tile_id(x, y));
+}
+
+TileMap::AttributesView
+TileMap::get_attributes_view() const
+{
+  const auto& attributes = m_tileset->get_attributes();
+  return AttributesView(m_tiles.data(), m_width, m_height,
+                        attributes.data(), attributes.size());
+}
+
+void
+TileMap::prefetch_tiles() const
+{
+  m_tileset->prefetch(m_tiles);
+}
+
 uint32_t
 TileMap::get_tile_id_at(const Vector& pos) const
 {
@@ -539,6 +635,20 @@ TileMap::change(int x, int y, uint32_t newtile)
 {
   assert(x >= 0 && x < m_width && y >= 0 && y < m_height);
   m_tiles[y*m_width + x] = newtile;
+
+  notify_tiles_changed(Rect(x, y, x + 1, y + 1));
+}
+
+void
+TileMap::change_span(int x, int y, const std::vector<uint32_t>& newtiles)
+{
+  assert(x >= 0 && x + static_cast<int>(newtiles.size()) <= m_width && y >= 0 && y < m_height);
+  if (newtiles.empty())
+    return;
+
+  std::copy(newtiles.begin(), newtiles.end(), m_tiles.begin() + (y*m_width + x));
+
+  notify_tiles_changed(Rect(x, y, x + static_cast<int>(newtiles.size()), y + 1));
 }
 
 void
@@ -551,14 +661,131 @@ TileMap::change_at(const Vector& pos, uint32_t newtile)
 void
 TileMap::change_all(uint32_t oldtile, uint32_t newtile)
 {
-  for (int x = 0; x < get_width(); x++) {
-    for (int y = 0; y < get_height(); y++) {
-      if (get_tile_id(x,y) != oldtile)
+  Rect area(m_width, m_height, 0, 0);
+  for (int y = 0; y < m_height; ++y) {
+    for (int x = 0; x < m_width; ++x) {
+      auto& tile = m_tiles[y*m_width + x];
+      if (tile != oldtile)
         continue;
 
-      change(x,y,newtile);
+      tile = newtile;
+      area.left = std::min(area.left, x);
+      area.top = std::min(area.top, y);
+      area.right = std::max(area.right, x + 1);
+      area.bottom = std::max(area.bottom, y + 1);
     }
   }
+
+  if (!area.empty()) {
+    notify_tiles_changed(area);
+  }
+}
+
+bool
+TileMap::clip_rect(int& x, int& y, int& width, int& height) const
+{
+  if (x < 0) {
+    width += x;
+    x = 0;
+  }
+  if (y < 0) {
+    height += y;
+    y = 0;
+  }
+  width = std::min(width, m_width - x);
+  height = std::min(height, m_height - y);
+  return width > 0 && height > 0;
+}
+
+void
+TileMap::set_row(int x, int y, const std::vector<uint32_t>& newtiles)
+{
+  int width = static_cast<int>(newtiles.size());
+  int height = 1;
+  const int first = x;
+  if (!clip_rect(x, y, width, height))
+    return;
+
+  auto begin = newtiles.begin() + (x - first);
+  std::copy(begin, begin + width, m_tiles.begin() + (y*m_width + x));
+
+  notify_tiles_changed(Rect(x, y, x + width, y + 1));
+}
+
+void
+TileMap::fill_rect(int x, int y, int width, int height, uint32_t newtile)
+{
+  if (!clip_rect(x, y, width, height))
+    return;
+
+  for (int row = y; row < y + height; ++row) {
+    auto begin = m_tiles.begin() + (row*m_width + x);
+    std::fill(begin, begin + width, newtile);
+  }
+
+  notify_tiles_changed(Rect(x, y, x + width, y + height));
+}
+
+void
+TileMap::copy_region(int src_x, int src_y, int width, int height, int dst_x, int dst_y)
+{
+  // clip source and destination against each other, so that both
+  // keep the same size
+  const int left = std::min(src_x, dst_x);
+  const int top = std::min(src_y, dst_y);
+  if (left < 0) {
+    width += left;
+    src_x -= left;
+    dst_x -= left;
+  }
+  if (top < 0) {
+    height += top;
+    src_y -= top;
+    dst_y -= top;
+  }
+  width = std::min(width, m_width - std::max(src_x, dst_x));
+  height = std::min(height, m_height - std::max(src_y, dst_y));
+  if (width <= 0 || height <= 0)
+    return;
+
+  // walk the rows away from the destination, so that overlapping
+  // rows are read before they get overwritten
+  const bool upwards = dst_y > src_y;
+  for (int i = 0; i < height; ++i) {
+    const int row = upwards ? height - 1 - i : i;
+    auto src = m_tiles.begin() + ((src_y + row)*m_width + src_x);
+    auto dst = m_tiles.begin() + ((dst_y + row)*m_width + dst_x);
+    if (dst_y == src_y && dst_x > src_x) {
+      std::copy_backward(src, src + width, dst + width);
+    } else {
+      std::copy(src, src + width, dst);
+    }
+  }
+
+  notify_tiles_changed(Rect(dst_x, dst_y, dst_x + width, dst_y + height));
+}
+
+int
+TileMap::replace_in_rect(int x, int y, int width, int height, uint32_t oldtile, uint32_t newtile)
+{
+  if (oldtile == newtile || !clip_rect(x, y, width, height))
+    return 0;
+
+  int count = 0;
+  for (int row = y; row < y + height; ++row) {
+    auto begin = m_tiles.begin() + (row*m_width + x);
+    for (auto it = begin; it != begin + width; ++it) {
+      if (*it == oldtile) {
+        *it = newtile;
+        count += 1;
+      }
+    }
+  }
+
+  if (count > 0) {
+    notify_tiles_changed(Rect(x, y, x + width, y + height));
+  }
+  return count;
 }
 
 void
@@ -607,18 +834,136 @@ TileMap::move_by(const Vector& shift)
 void
 TileMap::update_effective_solid()
 {
+  bool old_solid = is_solid();
+
   if (!m_real_solid)
     m_effective_solid = false;
   else if (m_effective_solid && (m_current_alpha < 0.25f))
     m_effective_solid = false;
   else if (!m_effective_solid && (m_current_alpha >= 0.75f))
     m_effective_solid = true;
+
+  if (old_solid != is_solid()) {
+    for(auto& listener : m_listeners) {
+      listener->tilemap_solidity_changed(*this);
+    }
+  }
+}
+
+void
+TileMap::notify_tiles_changed()
+{
+  m_change_log.clear();
+  m_version += 1;
+  m_change_log.push_back({ m_version, m_version, Rect(0, 0, m_width, m_height), true });
+
+  if (m_change_depth > 0) {
+    m_changes_pending = true;
+    m_pending_area = Rect(0, 0, m_width, m_height);
+    return;
+  }
+
+  for(auto& listener : m_listeners) {
+    listener->tilemap_tiles_changed(*this, Rect(0, 0, m_width, m_height));
+  }
+}
+
+void
+TileMap::notify_tiles_changed(const Rect& area)
+{
+  m_version += 1;
+
+  if (m_change_depth > 0 && m_changes_pending) {
+    // still inside the same batch, extend its entry
+    auto& last = m_change_log.back();
+    last.last_version = m_version;
+    last.area = unite(last.area, area);
+    m_pending_area = unite(m_pending_area, area);
+    return;
+  }
+
+  if (m_change_log.size() >= CHANGE_LOG_SIZE) {
+    m_change_log.pop_front();
+  }
+  m_change_log.push_back({ m_version, m_version, area, false });
+
+  if (m_change_depth > 0) {
+    m_changes_pending = true;
+    m_pending_area = area;
+    return;
+  }
+
+  for(auto& listener : m_listeners) {
+    listener->tilemap_tiles_changed(*this, area);
+  }
+}
+
+bool
+TileMap::get_changed_area(uint32_t version, Rect& area) const
+{
+  area = Rect();
+  if (version == m_version)
+    return true;
+
+  if (version > m_version ||
+      m_change_log.empty() ||
+      m_change_log.front().first_version > version + 1)
+    return false;
+
+  for(auto it = m_change_log.rbegin(); it != m_change_log.rend() && it->last_version > version; ++it) {
+    if (it->full)
+      return false;
+    area = unite(area, it->area);
+  }
+  return true;
+}
+
+void
+TileMap::enable_tile_lights()
+{
+  if (!m_lights) {
+    m_lights = std::make_unique<TileMapLights>();
+  }
 }
 
 void
 TileMap::set_tileset(const TileSet* new_tileset)
 {
   m_tileset = new_tileset;
+  notify_tiles_changed();
+}
+
+void
+TileMap::add_listener(TileMapListener* listener)
+{
+  m_listeners.push_back(listener);
+}
+
+void
+TileMap::del_listener(TileMapListener* listener)
+{
+  m_listeners.erase(std::remove(m_listeners.begin(), m_listeners.end(), listener),
+                    m_listeners.end());
+}
+
+void
+TileMap::begin_changes()
+{
+  m_change_depth += 1;
+}
+
+void
+TileMap::end_changes()
+{
+  assert(m_change_depth > 0);
+  m_change_depth -= 1;
+
+  if (m_change_depth == 0 && m_changes_pending) {
+    m_changes_pending = false;
+    for(auto& listener : m_listeners) {
+      listener->tilemap_tiles_changed(*this, m_pending_area);
+    }
+  }
 }
 
 /* EOF */
@@ -18,6 +18,8 @@
 #define HEADER_SUPERTUX_OBJECT_TILEMAP_HPP
 
 #include <algorithm>
+#include <deque>
+#include <memory>
 
 #include "math/rect.hpp"
 #include "math/rectf.hpp"
@@ -33,6 +35,8 @@
 
 class DrawingContext;
 class Tile;
+class TileMapLights;
+class TileMapListener;
 class TileSet;
 
 /** This class is responsible for drawing the level tiles */
@@ -54,6 +58,7 @@ public:
   virtual void after_editor_set() override;
 
   virtual void update(float dt_sec) override;
+  virtual bool is_update_parallel_safe() const override;
   virtual void draw(DrawingContext& context) override;
 
   /** Move tilemap until at given node, then stop */
@@ -130,13 +135,79 @@ public:
   uint32_t get_tile_id(int x, int y) const;
   uint32_t get_tile_id_at(const Vector& pos) const;
 
+  /** The attributes and data of the tile at (x, y), taken from the
+      arrays of the TileSet instead of the Tile, 0 outside of the
+      tilemap */
+  uint32_t get_tile_attributes(int x, int y) const;
+  int get_tile_data(int x, int y) const;
+
+  /** Looks up the attributes of the tiles by position without going
+      through the Tile objects. Only valid until the tilemap is
+      changed. */
+  class AttributesView final
+  {
+  public:
+    AttributesView(const uint32_t* tiles, int width, int height,
+                   const uint32_t* attributes, size_t attribute_count) :
+      m_tiles(tiles),
+      m_width(width),
+      m_height(height),
+      m_attributes(attributes),
+      m_attribute_count(attribute_count)
+    {}
+
+    int get_width() const { return m_width; }
+    int get_height() const { return m_height; }
+
+    /** (x, y) must be inside of the tilemap */
+    uint32_t get(int x, int y) const
+    {
+      const uint32_t id = m_tiles[y * m_width + x];
+      return id < m_attribute_count ? m_attributes[id] : 0;
+    }
+
+  private:
+    const uint32_t* m_tiles;
+    int m_width;
+    int m_height;
+    const uint32_t* m_attributes;
+    size_t m_attribute_count;
+  };
+
+  AttributesView get_attributes_view() const;
+
+  /** Creates the images of all tiles used in the tilemap, instead of
+      when they are drawn for the first time */
+  void prefetch_tiles() const;
+
   void change(int x, int y, uint32_t newtile);
 
+  /** changes the tiles starting at (x, y) to the right, the row must
+      fit into the tilemap */
+  void change_span(int x, int y, const std::vector<uint32_t>& newtiles);
+
   void change_at(const Vector& pos, uint32_t newtile);
 
   /** changes all tiles with the given ID */
   void change_all(uint32_t oldtile, uint32_t newtile);
 
+  /** The following change whole areas at once and notify listeners
+      only once. Areas reaching outside of the tilemap are clipped. */
+
+  /** sets the tiles starting at (x, y) to the right to newtiles */
+  void set_row(int x, int y, const std::vector<uint32_t>& newtiles);
+
+  /** sets all tiles in the rectangle to newtile */
+  void fill_rect(int x, int y, int width, int height, uint32_t newtile);
+
+  /** copies the tiles of a rectangle to (dst_x, dst_y), source and
+      destination may overlap */
+  void copy_region(int src_x, int src_y, int width, int height, int dst_x, int dst_y);
+
+  /** changes all tiles with the ID oldtile in the rectangle, returns
+      the number of changed tiles */
+  int replace_in_rect(int x, int y, int width, int height, uint32_t oldtile, uint32_t newtile);
+
   void set_flip(Flip flip)
   {
     m_flip = flip;
@@ -174,8 +245,41 @@ public:
 
   void set_tileset(const TileSet* new_tileset);
 
+  /** Register a listener that gets notified about changes to
+      solidity and tiles of this tilemap */
+  void add_listener(TileMapListener* listener);
+  void del_listener(TileMapListener* listener);
+
+  /** Groups a series of changes, listeners are notified only once at
+      the matching end_changes() instead of on every change. Calls may
+      be nested. */
+  void begin_changes();
+  void end_changes();
+
+  /** Increases with every change of the tiles */
+  uint32_t get_version() const { return m_version; }
+
+  /** Sets area to the tiles changed after version, an empty rect if
+      there were none. Returns false if that is no longer known, as
+      too many changes happened since or the tilemap was resized, in
+      which case everything has to be considered changed. */
+  bool get_changed_area(uint32_t version, Rect& area) const;
+
+  /** Makes fire and lava tiles light up the lightmap, used in game
+      instead of one light object per tile */
+  void enable_tile_lights();
+
 private:
+  /** clips the rectangle to the tilemap, returns false if nothing is left */
+  bool clip_rect(int& x, int& y, int& width, int& height) const;
+
   void update_effective_solid();
+
+  /** Records a change of the tiles in area, or of the whole tilemap
+      including its size when called without one */
+  void notify_tiles_changed();
+  void notify_tiles_changed(const Rect& area);
+
   void float_channel(float target, float &current, float remaining_time, float dt_sec);
 
 public:
@@ -225,6 +329,30 @@ private:
   int m_new_offset_y;
   bool m_add_path;
 
+  std::vector<TileMapListener*> m_listeners;
+
+  int m_change_depth;
+  bool m_changes_pending;
+  Rect m_pending_area;
+
+  struct TileChange
+  {
+    /** versions covered by this change, consecutive changes inside
+        begin_changes() are merged into one */
+    uint32_t first_version;
+    uint32_t last_version;
+
+    Rect area;
+    bool full;
+  };
+
+  uint32_t m_version;
+
+  /** the most recent changes, oldest first */
+  std::deque<TileChange> m_change_log;
+
+  std::unique_ptr<TileMapLights> m_lights;
+
 private:
   TileMap(const TileMap&) = delete;
   TileMap& operator=(const TileMap&) = delete;
@@ -0,0 +1,181 @@
+//  SuperTux
+//  Copyright (C) 2018 Ingo Ruhnke <grumbel@gmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "object/tilemap_lights.hpp"
+
+#include <algorithm>
+#include <math.h>
+#include <stdlib.h>
+
+#include "math/rect.hpp"
+#include "math/util.hpp"
+#include "object/tilemap.hpp"
+#include "supertux/tile.hpp"
+#include "video/drawing_context.hpp"
+#include "video/surface.hpp"
+
+namespace {
+
+struct LightKind
+{
+  float min_alpha;
+  float max_alpha;
+  Color color;
+};
+
+const LightKind LIGHT_KINDS[] = {
+  // lava or lavaflow
+  { 0.8f, 1.0f, Color(1.0f, 0.3f, 0.0f, 1.0f) },
+  // torch
+  { 0.9f, 1.0f, Color(1.0f, 1.0f, 0.6f, 1.0f) }
+};
+
+/** The time wraps around to keep its precision. This has to be a
+    multiple of every cycle length (1.0, 1.2, 1.4, 1.6 and 1.8 s), or
+    the lights jump in their pulse when it does. */
+const float WRAP_TIME = 504.0f;
+
+} // namespace
+
+TileMapLights::TileMapLights() :
+  m_surface(Surface::from_file("images/objects/lightmap_light/lightmap_light.png")),
+  m_emitters(),
+  m_valid(false),
+  m_version(0),
+  m_time(0.0f),
+  m_srcrects(),
+  m_dstrects(GROUP_COUNT)
+{
+}
+
+void
+TileMapLights::update(float dt_sec)
+{
+  m_time = fmodf(m_time + dt_sec, WRAP_TIME);
+}
+
+void
+TileMapLights::sync(const TileMap& tilemap)
+{
+  if (m_valid && m_version == tilemap.get_version())
+    return;
+
+  Rect area;
+  if (m_valid && tilemap.get_changed_area(m_version, area))
+  {
+    // whether lava emits light also depends on the tiles left of and
+    // above it, so the tiles right of and below the area are affected
+    area = Rect(std::max(area.left, 0), std::max(area.top, 0),
+                std::min(area.right + 1, tilemap.get_width()),
+                std::min(area.bottom + 1, tilemap.get_height()));
+
+    m_emitters.erase(std::remove_if(m_emitters.begin(), m_emitters.end(),
+                                    [&area](const Emitter& emitter) {
+                                      return area.contains(emitter.x, emitter.y);
+                                    }),
+                     m_emitters.end());
+    scan(tilemap, area);
+  }
+  else
+  {
+    m_emitters.clear();
+    scan(tilemap, Rect(0, 0, tilemap.get_width(), tilemap.get_height()));
+  }
+
+  m_valid = true;
+  m_version = tilemap.get_version();
+}
+
+void
+TileMapLights::scan(const TileMap& tilemap, const Rect& area)
+{
+  for(int y = area.top; y < area.bottom; ++y)
+  {
+    for(int x = area.left; x < area.right; ++x)
+    {
+      const Tile& tile = tilemap.get_tile(x, y);
+      const uint32_t attributes = tile.get_attributes();
+      if (!(attributes & Tile::FIRE) || !tile.get_object_name().empty())
+        continue;
+
+      Kind kind;
+      if (attributes & Tile::HURTS)
+      {
+        // space lights a bit
+        if ((tilemap.get_tile(x - 1, y).get_attributes() == attributes && x % 3 != 0) ||
+            (tilemap.get_tile(x, y - 1).get_attributes() == attributes && y % 3 != 0))
+          continue;
+        kind = LAVA;
+      }
+      else
+      {
+        kind = TORCH;
+      }
+
+      const int cycle = abs(static_cast<int>(tilemap.get_tile_position(x, y).x) % 10) / 2;
+      const int phase = (x * 7 + y * 13) % PHASE_COUNT;
+      const int group = (kind * CYCLE_COUNT + cycle) * PHASE_COUNT + phase;
+      m_emitters.push_back({ x, y, static_cast<uint8_t>(group) });
+    }
+  }
+}
+
+void
+TileMapLights::draw(DrawingContext& context, const TileMap& tilemap)
+{
+  sync(tilemap);
+  if (m_emitters.empty())
+    return;
+
+  const Rectf cliprect = context.get_cliprect();
+  const Sizef size(static_cast<float>(m_surface->get_width()),
+                   static_cast<float>(m_surface->get_height()));
+  const Vector center_offset = Vector(16.0f, 16.0f) - Vector(size.width, size.height) / 2.0f;
+
+  for(const auto& emitter : m_emitters)
+  {
+    const Vector pos = tilemap.get_tile_position(emitter.x, emitter.y) + center_offset;
+    if (pos.x > cliprect.get_right() ||
+        pos.y > cliprect.get_bottom() ||
+        pos.x + size.width < cliprect.get_left() ||
+        pos.y + size.height < cliprect.get_top())
+      continue;
+
+    m_dstrects[emitter.group].push_back(Rectf(pos, size));
+  }
+
+  Canvas& canvas = context.light();
+  for(int group = 0; group < GROUP_COUNT; ++group)
+  {
+    auto& dstrects = m_dstrects[group];
+    if (dstrects.empty())
+      continue;
+
+    const auto& kind = LIGHT_KINDS[group / (CYCLE_COUNT * PHASE_COUNT)];
+    const float cycle_len = 1.0f + 0.2f * static_cast<float>((group / PHASE_COUNT) % CYCLE_COUNT);
+    const float phase = static_cast<float>(group % PHASE_COUNT) / static_cast<float>(PHASE_COUNT);
+
+    Color color = kind.color;
+    color.alpha *= kind.min_alpha + (kind.max_alpha - kind.min_alpha) *
+      cosf(math::TAU * (m_time / cycle_len + phase));
+
+    m_srcrects.assign(dstrects.size(), Rectf(m_surface->get_region()));
+    canvas.draw_surface_batch(*m_surface, m_srcrects, dstrects, color, 0, Blend::ADD);
+    dstrects.clear();
+  }
+}
+
+/* EOF */
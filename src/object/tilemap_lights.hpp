@@ -0,0 +1,87 @@
+//  SuperTux
+//  Copyright (C) 2018 Ingo Ruhnke <grumbel@gmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_OBJECT_TILEMAP_LIGHTS_HPP
+#define HEADER_SUPERTUX_OBJECT_TILEMAP_LIGHTS_HPP
+
+#include <stdint.h>
+#include <vector>
+
+#include "math/rectf.hpp"
+#include "video/surface_ptr.hpp"
+
+class DrawingContext;
+class Rect;
+class TileMap;
+
+/** The pulsing lights of the fire and lava tiles of a TileMap.
+
+    The emitting tiles are found once and then kept up to date
+    through TileMap::get_changed_area(). Lights are grouped by their
+    kind and pulse, so that each group goes to the lightmap as a
+    single batch. */
+class TileMapLights final
+{
+private:
+  enum Kind : uint8_t
+  {
+    LAVA,
+    TORCH,
+    KIND_COUNT
+  };
+
+  /** the pulse of a light depends on its x position, as in the old
+      per tile light objects, and its phase on its tile */
+  static const int CYCLE_COUNT = 5;
+  static const int PHASE_COUNT = 4;
+  static const int GROUP_COUNT = KIND_COUNT * CYCLE_COUNT * PHASE_COUNT;
+
+  struct Emitter
+  {
+    int x;
+    int y;
+    uint8_t group;
+  };
+
+public:
+  TileMapLights();
+
+  void update(float dt_sec);
+  void draw(DrawingContext& context, const TileMap& tilemap);
+
+private:
+  void sync(const TileMap& tilemap);
+  void scan(const TileMap& tilemap, const Rect& area);
+
+private:
+  SurfacePtr m_surface;
+  std::vector<Emitter> m_emitters;
+  bool m_valid;
+  uint32_t m_version;
+  float m_time;
+
+  /** reused between frames to avoid allocations */
+  std::vector<Rectf> m_srcrects;
+  std::vector<std::vector<Rectf> > m_dstrects;
+
+private:
+  TileMapLights(const TileMapLights&) = delete;
+  TileMapLights& operator=(const TileMapLights&) = delete;
+};
+
+#endif
+
+/* EOF */
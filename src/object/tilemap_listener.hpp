@@ -0,0 +1,42 @@
+//  SuperTux
+//  Copyright (C) 2018 Ingo Ruhnke <grumbel@gmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_OBJECT_TILEMAP_LISTENER_HPP
+#define HEADER_SUPERTUX_OBJECT_TILEMAP_LISTENER_HPP
+
+class Rect;
+class TileMap;
+
+/** Receives notifications about changes of a TileMap, see
+    TileMap::add_listener() */
+class TileMapListener
+{
+public:
+  virtual ~TileMapListener()
+  {}
+
+  /** Called whenever TileMap::is_solid() changes its value */
+  virtual void tilemap_solidity_changed(TileMap& tilemap) = 0;
+
+  /** Called after tiles of the tilemap have been changed, area is
+      given in tiles. It covers the whole tilemap when the tilemap was
+      resized or its tileset got replaced. */
+  virtual void tilemap_tiles_changed(TileMap& tilemap, const Rect& area) = 0;
+};
+
+#endif
+
+/* EOF */
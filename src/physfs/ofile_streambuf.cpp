@@ -45,21 +45,20 @@ OFileStreambuf::overflow(int c)
 {
   char c2 = static_cast<char>(c);
 
-  if(pbase() == pptr())
-    return 0;
+  if(pbase() != pptr()) {
+    size_t size = pptr() - pbase();
+    PHYSFS_sint64 res = PHYSFS_writeBytes(file, pbase(), size);
+    if(res < static_cast<PHYSFS_sint64>(size))
+      return traits_type::eof();
 
-  size_t size = pptr() - pbase();
-  PHYSFS_sint64 res = PHYSFS_writeBytes(file, pbase(), size);
-  if(res <= 0)
-    return traits_type::eof();
+    setp(buf, buf + sizeof(buf));
+  }
 
   if(c != traits_type::eof()) {
-    PHYSFS_sint64 res_ = PHYSFS_writeBytes(file, &c2, 1);
-    if(res_ <= 0)
-      return traits_type::eof();
+    *pptr() = c2;
+    pbump(1);
   }
 
-  setp(buf, buf + res);
   return 0;
 }
 
@@ -33,7 +33,7 @@ protected:
 
 private:
   PHYSFS_File* file;
-  char buf[1024];
+  char buf[64 * 1024];
 
 private:
   OFileStreambuf(const OFileStreambuf&) = delete;
@@ -16,9 +16,12 @@
 
 #include "physfs/physfs_file_system.hpp"
 
+#include <boost/filesystem.hpp>
 #include <physfs.h>
+#include <string.h>
 
 #include "physfs/ifile_stream.hpp"
+#include "util/file_system.hpp"
 
 PhysFSFileSystem::PhysFSFileSystem()
 {
@@ -59,4 +62,25 @@ PhysFSFileSystem::remove(const std::string& filename)
   return PHYSFS_delete(filename.c_str()) == 0;
 }
 
+bool
+PhysFSFileSystem::rename(const std::string& oldname, const std::string& newname)
+{
+  const char* write_dir = PHYSFS_getWriteDir();
+  if (!write_dir)
+    return false;
+
+  boost::system::error_code ec;
+  boost::filesystem::rename(::FileSystem::join(write_dir, oldname),
+                            ::FileSystem::join(write_dir, newname), ec);
+  return !ec;
+}
+
+bool
+PhysFSFileSystem::is_in_write_dir(const std::string& filename)
+{
+  const char* write_dir = PHYSFS_getWriteDir();
+  const char* real_dir = PHYSFS_getRealDir(filename.c_str());
+  return write_dir && real_dir && strcmp(write_dir, real_dir) == 0;
+}
+
 /* EOF */
@@ -25,6 +25,14 @@ public:
   static bool is_directory(const std::string& filename);
   static bool remove(const std::string& filenam);
 
+  /** Replaces @c newname with @c oldname in the write directory,
+      atomically where the platform allows it */
+  static bool rename(const std::string& oldname, const std::string& newname);
+
+  /** Returns true if filename is found in the write directory and
+      not in an archive or directory mounted in front of it */
+  static bool is_in_write_dir(const std::string& filename);
+
 public:
   PhysFSFileSystem();
 
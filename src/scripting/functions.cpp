@@ -33,6 +33,7 @@
 #include "supertux/textscroller_screen.hpp"
 #include "supertux/tile.hpp"
 #include "video/renderer.hpp"
+#include "video/texture_manager.hpp"
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
 #include "worldmap/tux.hpp"
@@ -184,6 +185,11 @@ void debug_worldmap_ghost(bool enable)
   worldmap->get_tux()->set_ghost_mode(enable);
 }
 
+void debug_texture_memory()
+{
+  TextureManager::current()->print_memory_usage(ConsoleBuffer::output);
+}
+
 void save_state()
 {
   auto worldmap = worldmap::WorldMap::current();
@@ -135,6 +135,11 @@ void debug_draw_editor_images(bool enable);
  */
 void debug_worldmap_ghost(bool enable);
 
+/**
+ * prints the memory used by textures and cached images per file
+ */
+void debug_texture_memory();
+
 /**
  * Changes music to musicfile
  */
@@ -68,6 +68,54 @@ TileMap::change_at(float x, float y, int newtile)
   object.change_at(Vector(x, y), newtile);
 }
 
+SQInteger
+TileMap::set_row(HSQUIRRELVM vm)
+{
+  SCRIPT_GUARD_DEFAULT;
+
+  SQInteger x;
+  SQInteger y;
+  if (SQ_FAILED(sq_getinteger(vm, 2, &x)) ||
+      SQ_FAILED(sq_getinteger(vm, 3, &y))) {
+    return sq_throwerror(vm, _SC("set_row: x and y have to be integers"));
+  }
+
+  std::vector<uint32_t> tiles(static_cast<size_t>(sq_getsize(vm, 4)));
+  for (size_t i = 0; i < tiles.size(); ++i) {
+    sq_pushinteger(vm, static_cast<SQInteger>(i));
+    SQInteger id;
+    if (SQ_FAILED(sq_get(vm, 4)) || SQ_FAILED(sq_getinteger(vm, -1, &id))) {
+      return sq_throwerror(vm, _SC("set_row: the array may only contain tile IDs"));
+    }
+    sq_pop(vm, 1);
+    tiles[i] = static_cast<uint32_t>(id);
+  }
+
+  object.set_row(static_cast<int>(x), static_cast<int>(y), tiles);
+  return 0;
+}
+
+void
+TileMap::fill_rect(int x, int y, int width, int height, int newtile)
+{
+  SCRIPT_GUARD_VOID;
+  object.fill_rect(x, y, width, height, newtile);
+}
+
+void
+TileMap::copy_region(int src_x, int src_y, int width, int height, int dst_x, int dst_y)
+{
+  SCRIPT_GUARD_VOID;
+  object.copy_region(src_x, src_y, width, height, dst_x, dst_y);
+}
+
+int
+TileMap::replace_in_rect(int x, int y, int width, int height, int oldtile, int newtile)
+{
+  SCRIPT_GUARD_DEFAULT;
+  return object.replace_in_rect(x, y, width, height, oldtile, newtile);
+}
+
 void
 TileMap::fade(float alpha, float seconds)
 {
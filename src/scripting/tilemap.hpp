@@ -18,8 +18,12 @@
 #define HEADER_SUPERTUX_SCRIPTING_TILEMAP_HPP
 
 #ifndef SCRIPTING_API
+#include <squirrel.h>
+
 #include "scripting/game_object.hpp"
 
+#define __custom(x)
+
 class TileMap;
 #endif
 
@@ -61,6 +65,27 @@ public:
   /** replaces the tile by given tile at position pos (in world coordinates) */
   void change_at(float x, float y, int newtile);
 
+  /**
+   * Replaces the tiles in row y, starting at column x, by the tile IDs
+   * in the given array: set_row(x, y, [id, id, ...])
+   */
+  SQInteger set_row(HSQUIRRELVM vm) __custom("x|tiia");
+
+  /** replaces all tiles in the rectangle by the given tile */
+  void fill_rect(int x, int y, int width, int height, int newtile);
+
+  /**
+   * Copies the tiles in the rectangle to the tile at (dst_x, dst_y).
+   * Source and destination may overlap.
+   */
+  void copy_region(int src_x, int src_y, int width, int height, int dst_x, int dst_y);
+
+  /**
+   * Replaces every tile with the ID oldtile in the rectangle by newtile,
+   * returns the number of replaced tiles
+   */
+  int replace_in_rect(int x, int y, int width, int height, int oldtile, int newtile);
+
   /**
    * Start fading the tilemap to opacity given by @c alpha.
    * Destination opacity will be reached after @c seconds seconds. Also influences solidity.
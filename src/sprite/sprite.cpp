@@ -141,7 +141,7 @@ Sprite::draw(Canvas& canvas, const Vector& pos, int layer,
 
   context.set_flip(context.get_flip() ^ flip);
 
-  canvas.draw_surface(m_action->surfaces[m_frameidx],
+  canvas.draw_surface(*m_action->surfaces[m_frameidx],
                       pos - Vector(m_action->x_offset, m_action->y_offset),
                       m_angle,
                       m_color,
@@ -52,6 +52,13 @@ public:
   /** Get current action total frames */
   int get_frames() const
   { return static_cast<int>(m_action->surfaces.size()); }
+  /** Get current action frames per second */
+  float get_fps() const
+  { return m_action->fps; }
+  /** Get a frame of the current action, for drawing many copies of
+      an animation without a Sprite for each */
+  const Surface& get_frame_surface(int frame) const
+  { return *m_action->surfaces[frame]; }
   /** Get sprite's name */
   const std::string& get_name() const
   { return m_data.name; }
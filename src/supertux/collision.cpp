@@ -45,18 +45,11 @@ inline void makePlane(const Vector& p1, const Vector& p2, Vector& n, float& c)
   c /= nval;
 }
 
-}
-
-bool rectangle_aatriangle(Constraints* constraints, const Rectf& rect,
-                          const AATriangle& triangle, const Vector& addl_ground_movement)
+/** Computes the part of the triangle's bbox the slope runs through
+    and the plane of the slope, points p with normal * p + c <= 0 are
+    inside the triangle */
+void get_aatriangle_plane(const AATriangle& triangle, Rectf& area, Vector& normal, float& c)
 {
-  if(!intersects(rect, triangle.bbox))
-    return false;
-
-  Vector normal;
-  float c = 0.0;
-  Vector p1;
-  Rectf area;
   switch(triangle.dir & AATriangle::DEFORM_MASK) {
     case 0:
       area.p1 = triangle.bbox.p1;
@@ -84,26 +77,87 @@ bool rectangle_aatriangle(Constraints* constraints, const Rectf& rect,
 
   switch(triangle.dir & AATriangle::DIRECTION_MASK) {
     case AATriangle::SOUTHWEST:
-      p1 = Vector(rect.p1.x, rect.p2.y);
       makePlane(area.p1, area.p2, normal, c);
       break;
     case AATriangle::NORTHEAST:
-      p1 = Vector(rect.p2.x, rect.p1.y);
       makePlane(area.p2, area.p1, normal, c);
       break;
     case AATriangle::SOUTHEAST:
-      p1 = rect.p2;
       makePlane(Vector(area.p1.x, area.p2.y),
                 Vector(area.p2.x, area.p1.y), normal, c);
       break;
     case AATriangle::NORTHWEST:
-      p1 = rect.p1;
       makePlane(Vector(area.p2.x, area.p1.y),
                 Vector(area.p1.x, area.p2.y), normal, c);
       break;
     default:
       assert(false);
   }
+}
+
+/** Clips the line to the rectangle (Liang-Barsky), returns false if
+    they don't overlap */
+bool clip_line(const Rectf& r, Vector& line_start, Vector& line_end)
+{
+  const Vector d = line_end - line_start;
+  const float p[4] = { -d.x, d.x, -d.y, d.y };
+  const float q[4] = { line_start.x - r.p1.x, r.p2.x - line_start.x,
+                       line_start.y - r.p1.y, r.p2.y - line_start.y };
+
+  float t0 = 0.0f;
+  float t1 = 1.0f;
+  for (int i = 0; i < 4; ++i) {
+    if (p[i] == 0) {
+      if (q[i] < 0)
+        return false;
+    } else {
+      const float t = q[i] / p[i];
+      if (p[i] < 0) {
+        t0 = std::max(t0, t);
+      } else {
+        t1 = std::min(t1, t);
+      }
+      if (t0 > t1)
+        return false;
+    }
+  }
+
+  const Vector start = line_start;
+  line_start = start + d * t0;
+  line_end = start + d * t1;
+  return true;
+}
+
+}
+
+bool rectangle_aatriangle(Constraints* constraints, const Rectf& rect,
+                          const AATriangle& triangle, const Vector& addl_ground_movement)
+{
+  if(!intersects(rect, triangle.bbox))
+    return false;
+
+  Vector normal;
+  float c = 0.0;
+  Vector p1;
+  Rectf area;
+  get_aatriangle_plane(triangle, area, normal, c);
+
+  switch(triangle.dir & AATriangle::DIRECTION_MASK) {
+    case AATriangle::SOUTHWEST:
+      p1 = Vector(rect.p1.x, rect.p2.y);
+      break;
+    case AATriangle::NORTHEAST:
+      p1 = Vector(rect.p2.x, rect.p1.y);
+      break;
+    case AATriangle::SOUTHEAST:
+      p1 = rect.p2;
+      break;
+    case AATriangle::NORTHWEST:
+      p1 = rect.p1;
+      break;
+    default:
+      assert(false);
+  }
 
   float n_p1 = -(normal * p1);
   float depth = n_p1 - c;
@@ -211,6 +265,22 @@ bool line_intersects_line(const Vector& line1_start, const Vector& line1_end, co
 
 }
 
+bool line_intersects_aatriangle(const AATriangle& triangle, const Vector& line_start, const Vector& line_end)
+{
+  Vector start = line_start;
+  Vector end = line_end;
+  if (!clip_line(triangle.bbox, start, end))
+    return false;
+
+  // the solid part of the bbox is a half-plane, so the clipped line
+  // enters it iff one of its ends does
+  Rectf area;
+  Vector normal;
+  float c = 0.0;
+  get_aatriangle_plane(triangle, area, normal, c);
+  return (normal * start + c <= 0) || (normal * end + c <= 0);
+}
+
 bool intersects_line(const Rectf& r, const Vector& line_start, const Vector& line_end)
 {
   Vector p1 = r.p1;
@@ -20,6 +20,7 @@
 #include "supertux/collision_hit.hpp"
 #include <limits>
 #include <algorithm> /* min/max */
+#include <stdint.h>
 
 class Vector;
 class Rectf;
@@ -119,6 +120,37 @@ private:
   float speed_bottom;
 };
 
+/** A point probe moving along a short segment, resolved in bulk
+    against the solid tilemaps by CollisionSystem::probe_tiles() */
+class TileProbe final
+{
+public:
+  TileProbe() :
+    pos(),
+    movement(),
+    attributes(0),
+    from_side(false)
+  {}
+
+  TileProbe(const Vector& pos_, const Vector& movement_) :
+    pos(pos_),
+    movement(movement_),
+    attributes(0),
+    from_side(false)
+  {}
+
+  /** position before the movement */
+  Vector pos;
+  Vector movement;
+
+  /** attributes of the solid or water tiles the probe ended up in,
+      0 if it is still free */
+  uint32_t attributes;
+
+  /** true if the probe entered the tile horizontally */
+  bool from_side;
+};
+
 /** checks if 2 rectangle intersect each other */
 bool intersects(const Rectf& r1, const Rectf& r2);
 
@@ -134,6 +166,9 @@ void set_rectangle_rectangle_constraints(Constraints* constraints,
 bool line_intersects_line(const Vector& line1_start, const Vector& line1_end, const Vector& line2_start, const Vector& line2_end);
 bool intersects_line(const Rectf& r, const Vector& line_start, const Vector& line_end);
 
+/** checks if the line passes through the solid part of a slope tile */
+bool line_intersects_aatriangle(const AATriangle& triangle, const Vector& line_start, const Vector& line_end);
+
 } // namespace collision
 
 #endif
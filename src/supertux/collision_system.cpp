@@ -17,11 +17,16 @@
 
 #include "supertux/collision_system.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdlib.h>
+#include <tuple>
+
 #include "editor/editor.hpp"
 #include "math/aatriangle.hpp"
 #include "math/rect.hpp"
 #include "object/tilemap.hpp"
-#include "object/player.hpp"
 #include "supertux/collision.hpp"
 #include "supertux/constants.hpp"
 #include "supertux/moving_object.hpp"
@@ -37,11 +42,32 @@ const float MAX_SPEED = 16.0f;
 // a small value... be careful as CD is very sensitive to it
 const float DELTA = .002f;
 
+/** size of the cells of the moving object index, in pixels */
+const float OBJECT_CELL_SIZE = 256.0f;
+
+int object_cell(float pos)
+{
+  // keeps far away (or NaN) positions from overflowing the cast
+  const float limit = 1.0e7f;
+  return static_cast<int>(std::floor(std::min(limit, std::max(-limit, pos)) / OBJECT_CELL_SIZE));
+}
+
 } // namespace
 
 CollisionSystem::CollisionSystem(Sector& sector) :
   m_sector(sector),
-  m_moving_objects()
+  m_moving_objects(),
+  m_tile_cache(),
+  m_tile_cache_width(0),
+  m_tile_cache_height(0),
+  m_tile_cache_valid(false),
+  m_tile_cache_revision(0),
+  m_cached_tilemaps(),
+  m_cached_versions(),
+  m_uncached_tilemaps(),
+  m_object_index(),
+  m_object_index_valid(false),
+  m_nearby_objects()
 {
 }
 
@@ -49,6 +75,7 @@ void
 CollisionSystem::add(MovingObject* object)
 {
   m_moving_objects.push_back(object);
+  m_object_index_valid = false;
 }
 
 void
@@ -57,6 +84,7 @@ CollisionSystem::remove(MovingObject* moving_object)
   m_moving_objects.erase(
     std::find(m_moving_objects.begin(), m_moving_objects.end(),
               moving_object));
+  m_object_index_valid = false;
 }
 
 void
@@ -145,91 +173,208 @@ void check_collisions(collision::Constraints* constraints,
 }
 
 void
-CollisionSystem::collision_tilemap(collision::Constraints* constraints,
-                                   const Vector& movement, const Rectf& dest,
-                                   MovingObject& object) const
+CollisionSystem::update_tile_cache() const
 {
-  // calculate rectangle where the object will move
-  float x1 = dest.get_left();
-  float x2 = dest.get_right();
-  float y1 = dest.get_top();
-  float y2 = dest.get_bottom();
+  bool valid = (m_tile_cache_valid &&
+                m_tile_cache_revision == m_sector.get_solid_tilemaps_revision());
+  if (valid) {
+    // a cached tilemap that started moving invalidates the cache
+    for(const auto& solids : m_cached_tilemaps) {
+      if (solids->get_offset() != Vector(0, 0)) {
+        valid = false;
+        break;
+      }
+    }
+  }
+
+  if (valid) {
+    // changed tiles only need their cells merged again
+    for(size_t i = 0; i < m_cached_tilemaps.size() && valid; ++i) {
+      const auto& solids = m_cached_tilemaps[i];
+      if (solids->get_version() == m_cached_versions[i])
+        continue;
+
+      Rect area;
+      if (!solids->get_changed_area(m_cached_versions[i], area)) {
+        valid = false;
+        break;
+      }
+      update_tile_cache_area(area);
+      m_cached_versions[i] = solids->get_version();
+    }
+  }
+
+  if (valid)
+    return;
+
+  m_cached_tilemaps.clear();
+  m_cached_versions.clear();
+  m_uncached_tilemaps.clear();
+  m_tile_cache_width = 0;
+  m_tile_cache_height = 0;
 
   for(const auto& solids : m_sector.get_solid_tilemaps()) {
-    // test with all tiles in this rectangle
-    Rect test_tiles = solids->get_tiles_overlapping(Rectf(x1, y1, x2, y2));
+    if (solids->get_offset() == Vector(0, 0) && !solids->get_walker()) {
+      m_cached_tilemaps.push_back(solids);
+      m_cached_versions.push_back(solids->get_version());
+      m_tile_cache_width = std::max(m_tile_cache_width, solids->get_width());
+      m_tile_cache_height = std::max(m_tile_cache_height, solids->get_height());
+    } else {
+      m_uncached_tilemaps.push_back(solids);
+    }
+  }
+
+  m_tile_cache.assign(m_tile_cache_width * m_tile_cache_height, 0);
+  for(const auto& solids : m_cached_tilemaps) {
+    const auto attributes = solids->get_attributes_view();
+    for(int y = 0; y < attributes.get_height(); ++y) {
+      uint32_t* row = &m_tile_cache[y * m_tile_cache_width];
+      for(int x = 0; x < attributes.get_width(); ++x) {
+        row[x] |= attributes.get(x, y);
+      }
+    }
+  }
 
-    for(int x = test_tiles.left; x < test_tiles.right; ++x) {
-      for(int y = test_tiles.top; y < test_tiles.bottom; ++y) {
-        const Tile& tile = solids->get_tile(x, y);
+  m_tile_cache_valid = true;
+  m_tile_cache_revision = m_sector.get_solid_tilemaps_revision();
+}
 
-        // skip non-solid tiles
-        if(!tile.is_solid ())
-          continue;
-        Rectf tile_bbox = solids->get_tile_bbox(x, y);
+void
+CollisionSystem::update_tile_cache_area(const Rect& area) const
+{
+  const int left = std::max(area.left, 0);
+  const int top = std::max(area.top, 0);
+  const int right = std::min(area.right, m_tile_cache_width);
+  const int bottom = std::min(area.bottom, m_tile_cache_height);
+
+  for(int y = top; y < bottom; ++y) {
+    std::fill(m_tile_cache.begin() + y * m_tile_cache_width + left,
+              m_tile_cache.begin() + y * m_tile_cache_width + right, 0);
+  }
+
+  for(const auto& solids : m_cached_tilemaps) {
+    const auto attributes = solids->get_attributes_view();
+    const int solids_right = std::min(right, attributes.get_width());
+    const int solids_bottom = std::min(bottom, attributes.get_height());
+    for(int y = top; y < solids_bottom; ++y) {
+      uint32_t* row = &m_tile_cache[y * m_tile_cache_width];
+      for(int x = left; x < solids_right; ++x) {
+        row[x] |= attributes.get(x, y);
+      }
+    }
+  }
+}
+
+template<typename F>
+bool
+CollisionSystem::visit_solid_tiles(const Rectf& rect, uint32_t mask, F func) const
+{
+  update_tile_cache();
 
-        /* If the tile is a unisolid tile, the "is_solid()" function above
-         * didn't do a thorough check. Calculate the position and (relative)
-         * movement of the object and determine whether or not the tile is
-         * solid with regard to those parameters. */
-        if(tile.is_unisolid ()) {
-          Vector relative_movement = movement
-            - solids->get_movement(/* actual = */ true);
+  if (!m_cached_tilemaps.empty()) {
+    int t_left   = std::max(0                  , int(floorf(rect.get_left  () / 32)));
+    int t_right  = std::min(m_tile_cache_width , int(ceilf (rect.get_right () / 32)));
+    int t_top    = std::max(0                  , int(floorf(rect.get_top   () / 32)));
+    int t_bottom = std::min(m_tile_cache_height, int(ceilf (rect.get_bottom() / 32)));
 
-          if (!tile.is_solid (tile_bbox, object.get_bbox(), relative_movement))
+    for(int y = t_top; y < t_bottom; ++y) {
+      for(int x = t_left; x < t_right; ++x) {
+        if (!(m_tile_cache[y * m_tile_cache_width + x] & mask))
+          continue;
+
+        for(const auto& solids : m_cached_tilemaps) {
+          if (x >= solids->get_width() || y >= solids->get_height())
             continue;
-        } /* if (tile.is_unisolid ()) */
-
-        if(tile.is_slope ()) { // slope tile
-          AATriangle triangle;
-          int slope_data = tile.get_data();
-          if (solids->get_flip() & VERTICAL_FLIP)
-            slope_data = AATriangle::vertical_flip(slope_data);
-          triangle = AATriangle(tile_bbox, slope_data);
-
-          collision::rectangle_aatriangle(constraints, dest, triangle,
-              solids->get_movement(/* actual = */ false));
-        } else { // normal rectangular tile
-          check_collisions(constraints, movement, dest, tile_bbox, nullptr, nullptr,
-              solids->get_movement(/* actual = */ false));
+
+          if (!func(*solids, x, y))
+            return false;
         }
       }
     }
   }
+
+  for(const auto& solids : m_uncached_tilemaps) {
+    Rect test_tiles = solids->get_tiles_overlapping(rect);
+
+    for(int y = test_tiles.top; y < test_tiles.bottom; ++y) {
+      for(int x = test_tiles.left; x < test_tiles.right; ++x) {
+        if (!func(*solids, x, y))
+          return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+void
+CollisionSystem::collision_tilemap(collision::Constraints* constraints,
+                                   const Vector& movement, const Rectf& dest,
+                                   MovingObject& object) const
+{
+  visit_solid_tiles(dest, Tile::SOLID,
+    [&](const TileMap& solids, int x, int y) {
+      const uint32_t attributes = solids.get_tile_attributes(x, y);
+
+      // skip non-solid tiles
+      if(!(attributes & Tile::SOLID))
+        return true;
+      Rectf tile_bbox = solids.get_tile_bbox(x, y);
+
+      /* If the tile is a unisolid tile, the SOLID check above didn't
+       * do a thorough check. Calculate the position and (relative)
+       * movement of the object and determine whether or not the tile is
+       * solid with regard to those parameters. */
+      if(attributes & Tile::UNISOLID) {
+        Vector relative_movement = movement
+          - solids.get_movement(/* actual = */ true);
+
+        if (!solids.get_tile(x, y).is_solid (tile_bbox, object.get_bbox(), relative_movement))
+          return true;
+      } /* if (attributes & Tile::UNISOLID) */
+
+      if(attributes & Tile::SLOPE) { // slope tile
+        AATriangle triangle;
+        int slope_data = solids.get_tile_data(x, y);
+        if (solids.get_flip() & VERTICAL_FLIP)
+          slope_data = AATriangle::vertical_flip(slope_data);
+        triangle = AATriangle(tile_bbox, slope_data);
+
+        collision::rectangle_aatriangle(constraints, dest, triangle,
+            solids.get_movement(/* actual = */ false));
+      } else { // normal rectangular tile
+        check_collisions(constraints, movement, dest, tile_bbox, nullptr, nullptr,
+            solids.get_movement(/* actual = */ false));
+      }
+      return true;
+    });
 }
 
 uint32_t
 CollisionSystem::collision_tile_attributes(const Rectf& dest, const Vector& mov) const
 {
-  float x1 = dest.p1.x;
-  float y1 = dest.p1.y;
-  float x2 = dest.p2.x;
-  float y2 = dest.p2.y;
-
   uint32_t result = 0;
-  for(auto& solids: m_sector.get_solid_tilemaps()) {
-    // test with all tiles in this rectangle
-    Rect test_tiles = solids->get_tiles_overlapping(Rectf(x1, y1, x2, y2));
-    // For ice (only), add a little fudge to recognize tiles Tux is standing on.
-    Rect test_tiles_ice = solids->get_tiles_overlapping(Rectf(x1, y1, x2, y2 + SHIFT_DELTA));
-
-    for(int x = test_tiles.left; x < test_tiles.right; ++x) {
-      int y;
-      for(y = test_tiles.top; y < test_tiles.bottom; ++y) {
-        const Tile& tile = solids->get_tile(x, y);
-
-        if ( tile.is_collisionful( solids->get_tile_bbox(x, y), dest, mov) ) {
-          result |= tile.get_attributes();
-        }
-      }
-      for(; y < test_tiles_ice.bottom; ++y) {
-        const Tile& tile = solids->get_tile(x, y);
-        if ( tile.is_collisionful( solids->get_tile_bbox(x, y), dest, mov) ) {
-          result |= (tile.get_attributes() & Tile::ICE);
+
+  // For ice (only), add a little fudge to recognize tiles Tux is standing on.
+  Rectf test_rect(dest.p1.x, dest.p1.y, dest.p2.x, dest.p2.y + SHIFT_DELTA);
+
+  visit_solid_tiles(test_rect, ~0u,
+    [&](const TileMap& solids, int x, int y) {
+      const uint32_t attributes = solids.get_tile_attributes(x, y);
+      if (!attributes)
+        return true;
+      Rectf tile_bbox = solids.get_tile_bbox(x, y);
+
+      if (!(attributes & Tile::UNISOLID) ||
+          solids.get_tile(x, y).is_collisionful(tile_bbox, dest, mov)) {
+        if (tile_bbox.get_top() < dest.p2.y) {
+          result |= attributes;
+        } else {
+          result |= (attributes & Tile::ICE);
         }
       }
-    }
-  }
+      return true;
+    });
 
   return result;
 }
@@ -541,6 +686,7 @@ CollisionSystem::update()
     moving_object->m_bbox = moving_object->m_dest;
     moving_object->m_movement = Vector(0, 0);
   }
+  m_object_index_valid = false;
 }
 
 bool
@@ -548,33 +694,25 @@ CollisionSystem::is_free_of_tiles(const Rectf& rect, const bool ignoreUnisolid)
 {
   using namespace collision;
 
-  for(const auto& solids : m_sector.get_solid_tilemaps()) {
-    // test with all tiles in this rectangle
-    Rect test_tiles = solids->get_tiles_overlapping(rect);
-
-    for(int x = test_tiles.left; x < test_tiles.right; ++x) {
-      for(int y = test_tiles.top; y < test_tiles.bottom; ++y) {
-        const Tile& tile = solids->get_tile(x, y);
-
-        if(!(tile.get_attributes() & Tile::SOLID))
-          continue;
-        if(tile.is_unisolid () && ignoreUnisolid)
-          continue;
-        if(tile.is_slope ()) {
-          AATriangle triangle;
-          Rectf tbbox = solids->get_tile_bbox(x, y);
-          triangle = AATriangle(tbbox, tile.get_data());
-          Constraints constraints;
-          if(!collision::rectangle_aatriangle(&constraints, rect, triangle))
-            continue;
-        }
-        // We have a solid tile that overlaps the given rectangle.
-        return false;
+  return visit_solid_tiles(rect, Tile::SOLID,
+    [&](const TileMap& solids, int x, int y) {
+      const uint32_t attributes = solids.get_tile_attributes(x, y);
+
+      if(!(attributes & Tile::SOLID))
+        return true;
+      if((attributes & Tile::UNISOLID) && ignoreUnisolid)
+        return true;
+      if(attributes & Tile::SLOPE) {
+        AATriangle triangle;
+        Rectf tbbox = solids.get_tile_bbox(x, y);
+        triangle = AATriangle(tbbox, solids.get_tile_data(x, y));
+        Constraints constraints;
+        if(!collision::rectangle_aatriangle(&constraints, rect, triangle))
+          return true;
       }
-    }
-  }
-
-  return true;
+      // We have a solid tile that overlaps the given rectangle.
+      return false;
+    });
 }
 
 bool
@@ -615,33 +753,136 @@ CollisionSystem::is_free_of_movingstatics(const Rectf& rect, const MovingObject*
   return true;
 }
 
-bool
-CollisionSystem::free_line_of_sight(const Vector& line_start, const Vector& line_end, const MovingObject* ignore_object) const
+namespace {
+
+/** Calls func(x, y) for the cells of a grid of 32x32 tiles, sized
+    width x height, that the line passes through, in order from
+    line_start to line_end (Amanatides & Woo voxel traversal). Stops
+    and returns false as soon as func returns false. */
+template<typename F>
+bool traverse_tiles(const Vector& line_start, const Vector& line_end,
+                    int width, int height, F func)
 {
-  using namespace collision;
+  int x = static_cast<int>(floorf(line_start.x / 32.0f));
+  int y = static_cast<int>(floorf(line_start.y / 32.0f));
+  const int end_x = static_cast<int>(floorf(line_end.x / 32.0f));
+  const int end_y = static_cast<int>(floorf(line_end.y / 32.0f));
+
+  const Vector dir = line_end - line_start;
+  const int step_x = (dir.x > 0) ? 1 : -1;
+  const int step_y = (dir.y > 0) ? 1 : -1;
+
+  const float infinity = std::numeric_limits<float>::infinity();
+
+  // line parameter at which the next vertical/horizontal cell border is crossed
+  float t_max_x = infinity;
+  float t_max_y = infinity;
+  float t_delta_x = infinity;
+  float t_delta_y = infinity;
+  if (dir.x != 0) {
+    const float border = static_cast<float>((dir.x > 0) ? x + 1 : x) * 32.0f;
+    t_max_x = (border - line_start.x) / dir.x;
+    t_delta_x = 32.0f / fabsf(dir.x);
+  }
+  if (dir.y != 0) {
+    const float border = static_cast<float>((dir.y > 0) ? y + 1 : y) * 32.0f;
+    t_max_y = (border - line_start.y) / dir.y;
+    t_delta_y = 32.0f / fabsf(dir.y);
+  }
 
-  // check if no tile is in the way
-  float lsx = std::min(line_start.x, line_end.x);
-  float lex = std::max(line_start.x, line_end.x);
-  float lsy = std::min(line_start.y, line_end.y);
-  float ley = std::max(line_start.y, line_end.y);
-  for (float test_x = lsx; test_x <= lex; test_x += 16) {
-    for (float test_y = lsy; test_y <= ley; test_y += 16) {
-      for(const auto& solids : m_sector.get_solid_tilemaps()) {
-        const Tile& tile = solids->get_tile_at(Vector(test_x, test_y));
-        // FIXME: check collision with slope tiles
-        if((tile.get_attributes() & Tile::SOLID)) return false;
-      }
+  // bounding the number of steps keeps rounding errors from running
+  // past the end cell
+  const int steps = abs(end_x - x) + abs(end_y - y);
+  for (int i = 0; ; ++i) {
+    if (x >= 0 && x < width && y >= 0 && y < height) {
+      if (!func(x, y))
+        return false;
     }
+
+    if (i == steps)
+      break;
+
+    if (t_max_x < t_max_y) {
+      x += step_x;
+      t_max_x += t_delta_x;
+    } else {
+      y += step_y;
+      t_max_y += t_delta_y;
+    }
+  }
+
+  return true;
+}
+
+} // namespace
+
+bool
+CollisionSystem::is_free_of_tiles(const Vector& line_start, const Vector& line_end) const
+{
+  update_tile_cache();
+
+  auto tile_blocks = [&line_start, &line_end](const TileMap& solids, int x, int y) {
+    const uint32_t attributes = solids.get_tile_attributes(x, y);
+    if (!(attributes & Tile::SOLID))
+      return false;
+    if (!(attributes & Tile::SLOPE))
+      return true;
+
+    int slope_data = solids.get_tile_data(x, y);
+    if (solids.get_flip() & VERTICAL_FLIP)
+      slope_data = AATriangle::vertical_flip(slope_data);
+    return collision::line_intersects_aatriangle(AATriangle(solids.get_tile_bbox(x, y), slope_data),
+                                                 line_start, line_end);
+  };
+
+  if (!m_cached_tilemaps.empty()) {
+    bool free = traverse_tiles(line_start, line_end, m_tile_cache_width, m_tile_cache_height,
+      [&](int x, int y) {
+        if (!(m_tile_cache[y * m_tile_cache_width + x] & Tile::SOLID))
+          return true;
+
+        for(const auto& solids : m_cached_tilemaps) {
+          if (x >= solids->get_width() || y >= solids->get_height())
+            continue;
+          if (tile_blocks(*solids, x, y))
+            return false;
+        }
+        return true;
+      });
+    if (!free)
+      return false;
+  }
+
+  for(const auto& solids : m_uncached_tilemaps) {
+    const Vector offset = solids->get_offset();
+    bool free = traverse_tiles(line_start - offset, line_end - offset,
+                               solids->get_width(), solids->get_height(),
+      [&](int x, int y) {
+        return !tile_blocks(*solids, x, y);
+      });
+    if (!free)
+      return false;
   }
 
-  // check if no object is in the way
+  return true;
+}
+
+bool
+CollisionSystem::is_free_of_objects(const Vector& line_start, const Vector& line_end, const MovingObject* ignore_object) const
+{
+  using namespace collision;
+
+  const Rectf line_bbox(std::min(line_start.x, line_end.x), std::min(line_start.y, line_end.y),
+                        std::max(line_start.x, line_end.x), std::max(line_start.y, line_end.y));
+
   for(const auto& moving_object : m_moving_objects) {
     if (moving_object == ignore_object) continue;
     if (!moving_object->is_valid()) continue;
     if ((moving_object->get_group() == COLGROUP_MOVING)
         || (moving_object->get_group() == COLGROUP_MOVING_STATIC)
         || (moving_object->get_group() == COLGROUP_STATIC)) {
+      // cheap rejection before testing the four edges
+      if (!intersects(line_bbox, moving_object->get_bbox())) continue;
       if(intersects_line(moving_object->get_bbox(), line_start, line_end)) return false;
     }
   }
@@ -649,25 +890,136 @@ CollisionSystem::free_line_of_sight(const Vector& line_start, const Vector& line
   return true;
 }
 
-std::vector<MovingObject*>
-CollisionSystem::get_nearby_objects (const Vector& center, float max_distance) const
+bool
+CollisionSystem::free_line_of_sight(const Vector& line_start, const Vector& line_end, const MovingObject* ignore_object) const
+{
+  return (is_free_of_tiles(line_start, line_end) &&
+          is_free_of_objects(line_start, line_end, ignore_object));
+}
+
+void
+CollisionSystem::probe_tiles(std::vector<collision::TileProbe>& probes) const
 {
-  std::vector<MovingObject*> ret;
-  std::vector<Player*> players = Sector::get().get_players();
+  update_tile_cache();
+
+  auto probe_tile = [](const TileMap& solids, collision::TileProbe& probe) {
+    const Vector offset = solids.get_offset();
+    const Vector end = probe.pos + probe.movement;
+    const int tx = static_cast<int>(floorf((end.x - offset.x) / 32.0f));
+    const int ty = static_cast<int>(floorf((end.y - offset.y) / 32.0f));
+
+    const uint32_t attributes = solids.get_tile_attributes(tx, ty);
+    if(!(attributes & (Tile::WATER | Tile::SOLID)))
+      return;
+
+    const Rectf tile_bbox = solids.get_tile_bbox(tx, ty);
+    if((attributes & Tile::UNISOLID) &&
+       !solids.get_tile(tx, ty).is_solid(tile_bbox, Rectf(probe.pos, probe.pos),
+                                         probe.movement - solids.get_movement(/* actual = */ true)))
+      return;
 
-  for(const auto& player_ : players) {
-    float distance = player_->get_bbox().distance(center);
-    if (distance <= max_distance)
-      ret.push_back(player_);
+    if(attributes & Tile::SLOPE) {
+      int slope_data = solids.get_tile_data(tx, ty);
+      if (solids.get_flip() & VERTICAL_FLIP)
+        slope_data = AATriangle::vertical_flip(slope_data);
+
+      collision::Constraints constraints;
+      if(!collision::rectangle_aatriangle(&constraints, Rectf(end, end),
+                                          AATriangle(tile_bbox, slope_data)))
+        return;
+    }
+
+    // entered the tile through its left or right side when the
+    // start point was already in the same tile row
+    const int start_ty = static_cast<int>(floorf((probe.pos.y - offset.y) / 32.0f));
+    if(start_ty == ty)
+      probe.from_side = true;
+
+    probe.attributes |= attributes;
+  };
+
+  for(auto& probe : probes) {
+    probe.attributes = 0;
+    probe.from_side = false;
+
+    // static tilemaps only need to be looked at when the merged grid
+    // has something in the probed cell
+    const Vector end = probe.pos + probe.movement;
+    const int tx = static_cast<int>(floorf(end.x / 32.0f));
+    const int ty = static_cast<int>(floorf(end.y / 32.0f));
+    if (tx >= 0 && tx < m_tile_cache_width && ty >= 0 && ty < m_tile_cache_height &&
+        (m_tile_cache[ty * m_tile_cache_width + tx] & (Tile::WATER | Tile::SOLID))) {
+      for(const auto& solids : m_cached_tilemaps) {
+        probe_tile(*solids, probe);
+      }
+    }
+
+    for(const auto& solids : m_uncached_tilemaps) {
+      probe_tile(*solids, probe);
+    }
   }
+}
 
-  for (const auto& object_ : m_moving_objects) {
-    float distance = object_->get_bbox().distance(center);
-    if (distance <= max_distance)
-      ret.push_back(object_);
+void
+CollisionSystem::update_object_index() const
+{
+  m_object_index.clear();
+  for (const auto& object : m_moving_objects) {
+    const Vector middle = object->get_bbox().get_middle();
+    m_object_index.push_back({ object_cell(middle.x), object_cell(middle.y), object });
+  }
+
+  std::sort(m_object_index.begin(), m_object_index.end(),
+            [](const IndexEntry& lhs, const IndexEntry& rhs) {
+              return std::tie(lhs.cell_y, lhs.cell_x) < std::tie(rhs.cell_y, rhs.cell_x);
+            });
+  m_object_index_valid = true;
+}
+
+void
+CollisionSystem::collect_nearby_objects(const Vector& center, float max_distance, uint32_t group_mask) const
+{
+  if (!m_object_index_valid) {
+    update_object_index();
+  }
+
+  const size_t begin = m_nearby_objects.size();
+  auto add = [&](MovingObject* object) {
+    if (!(group_mask & (1u << object->get_group())))
+      return;
+
+    const float distance = object->get_bbox().distance(center);
+    if (distance <= max_distance) {
+      m_nearby_objects.push_back({ object, distance });
+    }
+  };
+
+  const int cell_x1 = object_cell(center.x - max_distance);
+  const int cell_y1 = object_cell(center.y - max_distance);
+  const int cell_x2 = object_cell(center.x + max_distance);
+  const int cell_y2 = object_cell(center.y + max_distance);
+
+  if (static_cast<size_t>(cell_y2 - cell_y1) >= m_object_index.size()) {
+    // more rows than objects, looking at each object is cheaper
+    for (const auto& entry : m_object_index) {
+      add(entry.object);
+    }
+  } else {
+    for (int cell_y = cell_y1; cell_y <= cell_y2; ++cell_y) {
+      auto it = std::lower_bound(m_object_index.begin(), m_object_index.end(), std::make_pair(cell_y, cell_x1),
+                                 [](const IndexEntry& entry, const std::pair<int, int>& cell) {
+                                   return std::tie(entry.cell_y, entry.cell_x) < std::tie(cell.first, cell.second);
+                                 });
+      for (; it != m_object_index.end() && it->cell_y == cell_y && it->cell_x <= cell_x2; ++it) {
+        add(it->object);
+      }
+    }
   }
 
-  return ret;
+  std::sort(m_nearby_objects.begin() + begin, m_nearby_objects.end(),
+            [](const NearbyObject& lhs, const NearbyObject& rhs) {
+              return lhs.distance < rhs.distance;
+            });
 }
 
 /* EOF */
@@ -25,8 +25,10 @@
 
 class DrawingContext;
 class MovingObject;
+class Rect;
 class Rectf;
 class Sector;
+class TileMap;
 class Vector;
 
 class CollisionSystem final
@@ -49,7 +51,43 @@ public:
   bool is_free_of_statics(const Rectf& rect, const MovingObject* ignore_object, const bool ignoreUnisolid) const;
   bool is_free_of_movingstatics(const Rectf& rect, const MovingObject* ignore_object) const;
   bool free_line_of_sight(const Vector& line_start, const Vector& line_end, const MovingObject* ignore_object) const;
-  std::vector<MovingObject*> get_nearby_objects(const Vector& center, float max_distance) const;
+
+  /** Walks the tiles along the line, true if none of them is solid.
+      Slopes only block the line where it passes their solid half. */
+  bool is_free_of_tiles(const Vector& line_start, const Vector& line_end) const;
+
+  /** true if the line doesn't cross the bbox of any moving, moving
+      static or static object other than ignore_object */
+  bool is_free_of_objects(const Vector& line_start, const Vector& line_end, const MovingObject* ignore_object) const;
+
+  /** Calls func(object, distance) for every moving object whose bbox
+      middle is within max_distance of center, nearest first. Only
+      objects in one of the groups in group_mask, a set of
+      (1 << CollisionGroup) bits, are visited.
+
+      The objects are looked up in a grid that is built on the first
+      query after the objects moved, so an object moved with set_pos()
+      after that is still searched for at its old place until the next
+      update(). */
+  template<typename F>
+  void for_each_nearby_object(const Vector& center, float max_distance,
+                              uint32_t group_mask, F func) const
+  {
+    // func may query again, results of nested calls go after ours
+    const size_t begin = m_nearby_objects.size();
+    collect_nearby_objects(center, max_distance, group_mask);
+    const size_t end = m_nearby_objects.size();
+    for (size_t i = begin; i < end; ++i) {
+      func(*m_nearby_objects[i].object, m_nearby_objects[i].distance);
+    }
+    m_nearby_objects.resize(begin);
+  }
+
+  /** Resolves a whole batch of point probes against the solid and
+      water tiles of all solid tilemaps in a single pass, meant for
+      particles that would otherwise each scan the tilemaps on their
+      own. Probes are expected to move less than one tile. */
+  void probe_tiles(std::vector<collision::TileProbe>& probes) const;
 
   const std::vector<MovingObject*>& get_moving_objects() const { return m_moving_objects; }
 
@@ -76,10 +114,74 @@ private:
 
   void collision_static_constrains(MovingObject& object);
 
+  /** Rebuilds the merged tile attribute grid when the set of solid
+      tilemaps changed since it was last built, or just the cells of
+      tiles that changed */
+  void update_tile_cache() const;
+
+  /** Merges the cells in area (in tiles) again */
+  void update_tile_cache_area(const Rect& area) const;
+
+  /** Calls func(tilemap, x, y) for every tile of the solid tilemaps
+      overlapping rect, skipping tiles of static tilemaps whose merged
+      attributes don't match mask. Stops and returns false as soon as
+      func returns false. */
+  template<typename F>
+  bool visit_solid_tiles(const Rectf& rect, uint32_t mask, F func) const;
+
+  /** Sorts the moving objects into m_object_index by the grid cell of
+      their bbox middle */
+  void update_object_index() const;
+
+  /** Appends the objects for for_each_nearby_object() to
+      m_nearby_objects, sorted by distance */
+  void collect_nearby_objects(const Vector& center, float max_distance, uint32_t group_mask) const;
+
 private:
   Sector& m_sector;
   std::vector<MovingObject*>  m_moving_objects;
 
+  /** OR-ed tile attributes of all static solid tilemaps (no path, no
+      offset) on one grid, so that collision queries only have to look
+      at the individual tilemaps for non-empty cells */
+  mutable std::vector<uint32_t> m_tile_cache;
+  mutable int m_tile_cache_width;
+  mutable int m_tile_cache_height;
+  mutable bool m_tile_cache_valid;
+  mutable uint32_t m_tile_cache_revision;
+
+  /** solid tilemaps merged into m_tile_cache */
+  mutable std::vector<TileMap*> m_cached_tilemaps;
+
+  /** TileMap::get_version() of each cached tilemap when it was last
+      merged into m_tile_cache */
+  mutable std::vector<uint32_t> m_cached_versions;
+
+  /** moving or offset solid tilemaps, always checked individually */
+  mutable std::vector<TileMap*> m_uncached_tilemaps;
+
+  struct IndexEntry
+  {
+    int cell_x;
+    int cell_y;
+    MovingObject* object;
+  };
+
+  /** m_moving_objects ordered by cell row and column, rebuilt when
+      needed after objects were moved, added or removed */
+  mutable std::vector<IndexEntry> m_object_index;
+  mutable bool m_object_index_valid;
+
+  struct NearbyObject
+  {
+    MovingObject* object;
+    float distance;
+  };
+
+  /** results of the running for_each_nearby_object() calls, reused to
+      avoid allocations */
+  mutable std::vector<NearbyObject> m_nearby_objects;
+
 private:
   CollisionSystem(const CollisionSystem&) = delete;
   CollisionSystem& operator=(const CollisionSystem&) = delete;
@@ -16,6 +16,8 @@
 
 #include "supertux/console.hpp"
 
+#include <algorithm>
+
 #include "math/sizef.hpp"
 #include "physfs/ifile_stream.hpp"
 #include "squirrel/squirrel_virtual_machine.hpp"
@@ -31,9 +33,16 @@
 static const float FADE_SPEED = 1;
 
 ConsoleBuffer::ConsoleBuffer() :
-  m_lines(),
-  m_console(nullptr)
+  m_console(nullptr),
+  m_lines(MAX_LINES),
+  m_lines_begin(0),
+  m_line_count(0),
+  m_log_message()
 {
+  for (auto& line : m_lines)
+  {
+    line.reserve(LINE_LENGTH + 1);
+  }
 }
 
 void
@@ -57,27 +66,66 @@ ConsoleBuffer::addLines(const std::string& s)
 }
 
 void
-ConsoleBuffer::addLine(const std::string& s_)
+ConsoleBuffer::addLine(const std::string& s)
 {
-  std::string s = s_;
-
   // output line to stderr
   std::cerr << s << std::endl;
 
-  // wrap long lines
-  std::string overflow;
-  int line_count = 0;
-  do {
-    m_lines.push_front(Font::wrap_to_chars(s, 99, &overflow));
-    line_count += 1;
-    s = overflow;
-  } while (s.length() > 0);
+  append_line(s.data(), s.size());
+}
 
-  // trim scrollback buffer
-  while (m_lines.size() >= 1000)
+void
+ConsoleBuffer::poll_log()
+{
+  while (log_pop_console_message(m_log_message))
+  {
+    append_lines(m_log_message.data(), m_log_message.size());
+  }
+}
+
+void
+ConsoleBuffer::append_lines(const char* text, size_t length)
+{
+  const char* end = text + length;
+  while (text < end)
   {
-    m_lines.pop_back();
+    const char* eol = std::find(text, end, '\n');
+    append_line(text, static_cast<size_t>(eol - text));
+    text = (eol == end) ? end : eol + 1;
   }
+}
+
+void
+ConsoleBuffer::append_line(const char* text, size_t length)
+{
+  // wrap long lines, breaking at the last space like Font::wrap_to_chars()
+  int line_count = 0;
+  do {
+    size_t count = length;
+    size_t skip = 0;
+    if (length > LINE_LENGTH)
+    {
+      size_t i = LINE_LENGTH;
+      while ((i > 0) && (text[i] != ' ')) i--;
+      if (i > 0)
+      {
+        count = i;
+        skip = 1;
+      }
+    }
+
+    // reuse the storage of the oldest line once the backbuffer is full
+    m_lines_begin = (m_lines_begin + MAX_LINES - 1) % MAX_LINES;
+    m_lines[m_lines_begin].assign(text, count);
+    if (m_line_count < MAX_LINES)
+    {
+      m_line_count += 1;
+    }
+
+    line_count += 1;
+    text += count + skip;
+    length -= count + skip;
+  } while (length > 0);
 
   if (m_console)
   {
@@ -501,6 +549,12 @@ Console::toggle()
 void
 Console::update(float dt_sec)
 {
+  m_buffer.poll_log();
+
+  if (log_take_console_open_request() && !hasFocus()) {
+    open();
+  }
+
   if(m_stayOpen > 0) {
     m_stayOpen -= dt_sec;
     if(m_stayOpen < 0)
@@ -527,11 +581,11 @@ Console::draw(DrawingContext& context) const
 
   context.push_transform();
   context.set_alpha(m_alpha);
-  context.color().draw_surface(m_background2,
+  context.color().draw_surface(*m_background2,
                                Vector(static_cast<float>(context.get_width() / 2 - m_background->get_width() / 2 - m_background->get_width() + m_backgroundOffset),
                                       m_height - static_cast<float>(m_background->get_height())),
                                layer);
-  context.color().draw_surface(m_background2,
+  context.color().draw_surface(*m_background2,
                                Vector(static_cast<float>(context.get_width()/2 - m_background->get_width()/2 + m_backgroundOffset),
                                       m_height - static_cast<float>(m_background->get_height())),
                                layer);
@@ -541,7 +595,7 @@ Console::draw(DrawingContext& context) const
        x < context.get_width();
        x += m_background->get_width())
   {
-    context.color().draw_surface(m_background, Vector(static_cast<float>(x),
+    context.color().draw_surface(*m_background, Vector(static_cast<float>(x),
                                                       m_height - static_cast<float>(m_background->get_height())),
                                  layer);
   }
@@ -572,13 +626,13 @@ Console::draw(DrawingContext& context) const
   }
 
   int skipLines = -m_offset;
-  for (std::list<std::string>::iterator i = m_buffer.m_lines.begin(); i != m_buffer.m_lines.end(); ++i)
+  for (size_t i = 0; i < m_buffer.get_line_count(); ++i)
   {
     if (skipLines-- > 0) continue;
     lineNo++;
     float py = static_cast<float>(m_height - 4.0f - static_cast<float>(lineNo) * m_font->get_height());
     if (py < -m_font->get_height()) break;
-    context.color().draw_text(m_font, *i, Vector(4.0f, py), ALIGN_LEFT, layer);
+    context.color().draw_text(m_font, m_buffer.get_line(i), Vector(4.0f, py), ALIGN_LEFT, layer);
   }
   context.pop_transform();
 }
@@ -36,8 +36,10 @@ public:
   static std::ostream output; /**< stream of characters to output to the console. Do not forget to send std::endl or to flush the stream. */
   static ConsoleStreamBuffer s_outputBuffer; /**< stream buffer used by output stream */
 
+  static const size_t MAX_LINES = 1000; /**< lines kept in the backbuffer */
+  static const size_t LINE_LENGTH = 99; /**< longer lines get wrapped */
+
 public:
-  std::list<std::string> m_lines; /**< backbuffer of lines sent to the console. New lines get added to front. */
   Console* m_console;
 
 public:
@@ -48,8 +50,24 @@ public:
 
   void flush(ConsoleStreamBuffer& buffer); /**< act upon changes in a ConsoleStreamBuffer */
 
+  /** pull in the messages the asynchronous logger mirrored for the console */
+  void poll_log();
+
+  size_t get_line_count() const { return m_line_count; }
+  const std::string& get_line(size_t i) const { return m_lines[(m_lines_begin + i) % MAX_LINES]; } /**< 0 is the newest line */
+
   void set_console(Console* console);
 
+private:
+  void append_lines(const char* text, size_t length); /**< like addLines, but without echoing to stderr */
+  void append_line(const char* text, size_t length);
+
+private:
+  std::vector<std::string> m_lines; /**< backbuffer of lines sent to the console, a ring of preallocated strings */
+  size_t m_lines_begin; /**< index of the newest line */
+  size_t m_line_count;
+  std::string m_log_message; /**< reused by poll_log() */
+
 private:
   ConsoleBuffer(const ConsoleBuffer&) = delete;
   ConsoleBuffer& operator=(const ConsoleBuffer&) = delete;
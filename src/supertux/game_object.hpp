@@ -63,6 +63,17 @@ public:
       in pause mode) */
   virtual void update(float dt_sec) = 0;
 
+  /** Returns true if update() only changes the object itself and
+      reads nothing that other objects change in their update(), so
+      that it can run on another thread and before the other objects
+      without changing the outcome. */
+  virtual bool is_update_parallel_safe() const { return false; }
+
+  /** Rough cost of update() in units of a trivial update, only when
+      the parallel safe objects add up to enough work are they spread
+      over the JobPool */
+  virtual size_t get_update_cost() const { return 1; }
+
   /** The GameObject should draw itself onto the provided
       DrawingContext if this function is called. */
   virtual void draw(DrawingContext& context) = 0;
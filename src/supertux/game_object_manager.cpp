@@ -20,7 +20,16 @@
 #include <algorithm>
 
 #include "object/tilemap.hpp"
-#include "supertux/sector.hpp"
+#include "util/job_pool.hpp"
+
+namespace {
+
+/** Total get_update_cost() of the parallel safe objects below which
+    they are updated serially, waking up the workers costs a few
+    microseconds while a unit of cost is roughly 10ns */
+const size_t MIN_PARALLEL_UPDATE_COST = 8192;
+
+} // namespace
 
 bool GameObjectManager::s_draw_solids_only = false;
 
@@ -29,9 +38,11 @@ GameObjectManager::GameObjectManager() :
   m_gameobjects(),
   m_gameobjects_new(),
   m_solid_tilemaps(),
+  m_solid_tilemaps_revision(0),
   m_objects_by_name(),
   m_objects_by_uid(),
-  m_name_resolve_requests()
+  m_name_resolve_requests(),
+  m_parallel_objects()
 {
 }
 
@@ -101,6 +112,7 @@ GameObjectManager::clear_objects()
   update_game_objects();
 
   for(const auto& obj: m_gameobjects) {
+    this_before_object_remove(*obj);
     before_object_remove(*obj);
   }
   m_gameobjects.clear();
@@ -109,13 +121,62 @@ GameObjectManager::clear_objects()
 void
 GameObjectManager::update(float dt_sec)
 {
+  if(update_parallel(dt_sec))
+    return;
+
+  for(const auto& object : m_gameobjects)
+  {
+    if(!object->is_valid())
+      continue;
+
+    object->update(dt_sec);
+  }
+}
+
+bool
+GameObjectManager::update_parallel(float dt_sec)
+{
+  auto pool = JobPool::current();
+  if(!pool || pool->get_num_workers() == 0)
+    return false;
+
+  m_parallel_objects.clear();
+  size_t cost = 0;
   for(const auto& object : m_gameobjects)
   {
+    if(object->is_valid() && object->is_update_parallel_safe())
+    {
+      m_parallel_objects.push_back(object.get());
+      cost += object->get_update_cost();
+    }
+  }
+
+  if(cost < MIN_PARALLEL_UPDATE_COST)
+    return false;
+
+  pool->parallel_for(m_parallel_objects.size(), [this, dt_sec](size_t i) {
+      m_parallel_objects[i]->update(dt_sec);
+    });
+
+  // an update might change whether another object is parallel safe,
+  // so skip exactly the objects that were collected above
+  size_t next_parallel = 0;
+  for(const auto& object : m_gameobjects)
+  {
+    if(next_parallel < m_parallel_objects.size() &&
+       m_parallel_objects[next_parallel] == object.get())
+    {
+      next_parallel += 1;
+      continue;
+    }
+
     if(!object->is_valid())
       continue;
 
     object->update(dt_sec);
   }
+
+  return true;
 }
 
 void
@@ -167,16 +228,6 @@ GameObjectManager::update_game_objects()
     }
     m_gameobjects_new.clear();
   }
-
-  { // update solid_tilemaps list
-    m_solid_tilemaps.clear();
-    for(const auto& obj : m_gameobjects)
-    {
-      const auto& tm = dynamic_cast<TileMap*>(obj.get());
-      if (!tm) continue;
-      if (tm->is_solid()) static_cast<Sector*>(this)->m_solid_tilemaps.push_back(tm);
-    }
-  }
 }
 
 void
@@ -194,6 +245,19 @@ GameObjectManager::this_before_object_add(GameObject& object)
 
     m_objects_by_uid[object.get_uid()] = &object;
   }
+
+  { // solid tilemaps
+    auto tilemap = dynamic_cast<TileMap*>(&object);
+    if (tilemap)
+    {
+      tilemap->add_listener(this);
+      if (tilemap->is_solid())
+      {
+        m_solid_tilemaps.push_back(tilemap);
+        m_solid_tilemaps_revision += 1;
+      }
+    }
+  }
 }
 
 void
@@ -210,6 +274,49 @@ GameObjectManager::this_before_object_remove(GameObject& object)
   { // by_id
     m_objects_by_uid.erase(object.get_uid());
   }
+
+  { // solid tilemaps
+    auto tilemap = dynamic_cast<TileMap*>(&object);
+    if (tilemap)
+    {
+      tilemap->del_listener(this);
+      auto it = std::find(m_solid_tilemaps.begin(), m_solid_tilemaps.end(), tilemap);
+      if (it != m_solid_tilemaps.end())
+      {
+        m_solid_tilemaps.erase(it);
+        m_solid_tilemaps_revision += 1;
+      }
+    }
+  }
+}
+
+void
+GameObjectManager::tilemap_solidity_changed(TileMap& tilemap)
+{
+  auto it = std::find(m_solid_tilemaps.begin(), m_solid_tilemaps.end(), &tilemap);
+  if (tilemap.is_solid())
+  {
+    if (it == m_solid_tilemaps.end())
+    {
+      m_solid_tilemaps.push_back(&tilemap);
+    }
+  }
+  else
+  {
+    if (it != m_solid_tilemaps.end())
+    {
+      m_solid_tilemaps.erase(it);
+    }
+  }
+  m_solid_tilemaps_revision += 1;
+}
+
+void
+GameObjectManager::tilemap_tiles_changed(TileMap& /*tilemap*/, const Rect& /*area*/)
+{
+  // the collision tile cache follows tile changes through
+  // TileMap::get_changed_area(), only the set of solid tilemaps is
+  // tracked by the revision
 }
 
 float
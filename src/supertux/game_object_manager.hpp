@@ -21,7 +21,9 @@
 #include <functional>
 #include <unordered_map>
 #include <vector>
+#include <stdint.h>
 
+#include "object/tilemap_listener.hpp"
 #include "supertux/game_object.hpp"
 #include "util/uid_generator.hpp"
 
@@ -30,7 +32,7 @@ class TileMap;
 
 template<class T> class GameObjectRange;
 
-class GameObjectManager
+class GameObjectManager : public TileMapListener
 {
 public:
   static bool s_draw_solids_only;
@@ -152,10 +154,24 @@ public:
 
   const std::vector<TileMap*>& get_solid_tilemaps() const { return m_solid_tilemaps; }
 
+  /** Incremented whenever the set of solid tilemaps changes, caches
+      derived from the solid tilemaps can compare against it to find
+      out whether they are stale. Changes to the tiles themselves are
+      available through TileMap::get_changed_area(). */
+  uint32_t get_solid_tilemaps_revision() const { return m_solid_tilemaps_revision; }
+
+  virtual void tilemap_solidity_changed(TileMap& tilemap) override;
+  virtual void tilemap_tiles_changed(TileMap& tilemap, const Rect& area) override;
+
 protected:
   void process_resolve_requests();
 
 private:
+  /** Updates the parallel safe objects on the JobPool and then the
+      rest, returns false without updating anything when there is too
+      little work to be worth waking up the workers */
+  bool update_parallel(float dt_sec);
+
   void this_before_object_add(GameObject& object);
   void this_before_object_remove(GameObject& object);
 
@@ -167,14 +183,20 @@ private:
   /** container for newly created objects, they'll be added in update_game_objects() */
   std::vector<std::unique_ptr<GameObject>> m_gameobjects_new;
 
-  /** Fast access to solid tilemaps */
+  /** Fast access to solid tilemaps, kept up to date by the add and
+      remove hooks and the TileMapListener notifications */
   std::vector<TileMap*> m_solid_tilemaps;
+  uint32_t m_solid_tilemaps_revision;
 
   std::unordered_map<std::string, GameObject*> m_objects_by_name;
   std::unordered_map<UID, GameObject*> m_objects_by_uid;
 
   std::vector<NameResolveRequest> m_name_resolve_requests;
 
+  /** reused by update_parallel() for the objects that can be updated
+      in parallel */
+  std::vector<GameObject*> m_parallel_objects;
+
 private:
   GameObjectManager(const GameObjectManager&) = delete;
   GameObjectManager& operator=(const GameObjectManager&) = delete;
@@ -32,6 +32,7 @@ Config::Config() :
   use_fullscreen(false),
   video(VideoSystem::VIDEO_AUTO),
   try_vsync(true),
+  frame_interpolation(true),
   show_fps(false),
   show_player_pos(false),
   sound_enabled(true),
@@ -54,6 +55,8 @@ Config::Config() :
   transitions_enabled(true),
   confirmation_dialog(false),
   pause_on_focusloss(true),
+  document_cache(true),
+  editor_undo_memory(16 * 1024),
   repository_url()
 {
 }
@@ -75,6 +78,8 @@ Config::load()
   config_lisp.get("developer", developer_mode);
   config_lisp.get("confirmation_dialog", confirmation_dialog);
   config_lisp.get("pause_on_focusloss", pause_on_focusloss);
+  config_lisp.get("document_cache", document_cache);
+  config_lisp.get("editor_undo_memory", editor_undo_memory);
 
   if(is_christmas()) {
     if(!config_lisp.get("christmas", christmas_mode))
@@ -95,6 +100,7 @@ Config::load()
     config_video_lisp->get("video", video_string);
     video = VideoSystem::get_video_system(video_string);
     config_video_lisp->get("vsync", try_vsync);
+    config_video_lisp->get("frame_interpolation", frame_interpolation);
 
     config_video_lisp->get("fullscreen_width",  fullscreen_size.width);
     config_video_lisp->get("fullscreen_height", fullscreen_size.height);
@@ -178,6 +184,8 @@ Config::save()
   writer.write("developer", developer_mode);
   writer.write("confirmation_dialog", confirmation_dialog);
   writer.write("pause_on_focusloss", pause_on_focusloss);
+  writer.write("document_cache", document_cache);
+  writer.write("editor_undo_memory", editor_undo_memory);
   if(is_christmas()) {
     writer.write("christmas", christmas_mode);
   }
@@ -189,6 +197,7 @@ Config::save()
   writer.write("fullscreen", use_fullscreen);
   writer.write("video", VideoSystem::get_video_string(video));
   writer.write("vsync", try_vsync);
+  writer.write("frame_interpolation", frame_interpolation);
 
   writer.write("fullscreen_width",  fullscreen_size.width);
   writer.write("fullscreen_height", fullscreen_size.height);
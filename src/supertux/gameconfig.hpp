@@ -54,6 +54,11 @@ public:
   bool use_fullscreen;
   VideoSystem::Enum video;
   bool try_vsync;
+
+  /** render at the display rate and draw objects between their last
+      two simulated positions, only used while vsync is on */
+  bool frame_interpolation;
+
   bool show_fps;
   bool show_player_pos;
   bool sound_enabled;
@@ -97,6 +102,12 @@ public:
   bool confirmation_dialog;
   bool pause_on_focusloss;
 
+  /** keep binary copies of parsed levels in the user directory */
+  bool document_cache;
+
+  /** memory the undo history of the editor may use, in KiB */
+  int editor_undo_memory;
+
   std::string repository_url;
 
   bool is_christmas() const {
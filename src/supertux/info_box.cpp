@@ -70,12 +70,12 @@ InfoBox::draw(DrawingContext& context)
   {
     // draw the scrolling arrows
     if (arrow_scrollup.get() && firstline > 0)
-      context.color().draw_surface(arrow_scrollup,
+      context.color().draw_surface(*arrow_scrollup,
                                    Vector(x1 + width  - static_cast<float>(arrow_scrollup->get_width()),  // top-right corner of box
                                           y1), LAYER_GUI);
 
     if (arrow_scrolldown.get() && linesLeft && firstline < lines.size()-1)
-      context.color().draw_surface(arrow_scrolldown,
+      context.color().draw_surface(*arrow_scrolldown,
                                    Vector(x1 + width  - static_cast<float>(arrow_scrolldown->get_width()),  // bottom-light corner of box
                                           y1 + height - static_cast<float>(arrow_scrolldown->get_height())),
                                    LAYER_GUI);
@@ -161,7 +161,7 @@ InfoBoxLine::draw(DrawingContext& context, const Rectf& bbox, int layer)
   Vector position = bbox.p1;
   switch (lineType) {
     case IMAGE:
-      context.color().draw_surface(image, Vector( (bbox.p1.x + bbox.p2.x - static_cast<float>(image->get_width())) / 2.0f, position.y), layer);
+      context.color().draw_surface(*image, Vector( (bbox.p1.x + bbox.p2.x - static_cast<float>(image->get_width())) / 2.0f, position.y), layer);
       break;
     case NORMAL_LEFT:
       context.color().draw_text(font, text, Vector(position.x, position.y), ALIGN_LEFT, layer, color);
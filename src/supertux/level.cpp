@@ -19,6 +19,7 @@
 #include "badguy/goldbomb.hpp"
 #include "object/bonus_block.hpp"
 #include "object/coin.hpp"
+#include "physfs/ofile_stream.hpp"
 #include "physfs/physfs_file_system.hpp"
 #include "supertux/sector.hpp"
 #include "trigger/secretarea_trigger.hpp"
@@ -76,30 +77,41 @@ Level::save(const std::string& filepath, bool retry)
       }
     }
 
-    Writer writer(filepath);
-    writer.start_list("supertux-level");
-    // Starts writing to supertux level file. Keep this at the very beginning.
+    // write to a temporary file first, so a failed save never leaves
+    // a truncated level behind
+    const std::string tmp_filepath = filepath + ".tmp";
+    bool written = false;
+    try
+    {
+      OFileStream out(tmp_filepath);
+      save(out);
 
-    writer.write("version", 2);
-    writer.write("name", m_name, true);
-    writer.write("author", m_author, false);
-    writer.write("tileset", m_tileset, false);
-    if (m_contact != "") {
-      writer.write("contact", m_contact, false);
+      out.flush();
+      written = static_cast<bool>(out);
     }
-    if (m_license != "") {
-      writer.write("license", m_license, false);
-    }
-    if (m_target_time != 0.0f){
-      writer.write("target-time", m_target_time);
+    catch(...)
+    {
+      PHYSFS_delete(tmp_filepath.c_str());
+      throw;
     }
 
-    for(auto& sector : m_sectors) {
-      sector->save(writer);
+    // the temporary file is removed on failure, so it doesn't get in
+    // the way of the next attempt
+    if (!written)
+    {
+      std::ostringstream msg;
+      msg << "Couldn't write '" << tmp_filepath << "': " << PHYSFS_getLastErrorCode();
+      PHYSFS_delete(tmp_filepath.c_str());
+      throw std::runtime_error(msg.str());
     }
 
-    // Ends writing to supertux level file. Keep this at the very end.
-    writer.end_list("supertux-level");
+    if (!PhysFSFileSystem::rename(tmp_filepath, filepath))
+    {
+      PHYSFS_delete(tmp_filepath.c_str());
+      std::ostringstream msg;
+      msg << "Couldn't replace '" << filepath << "' with '" << tmp_filepath << "'";
+      throw std::runtime_error(msg.str());
+    }
     log_warning << "Level saved as " << filepath << "." << std::endl;
   } catch(std::exception& e) {
     if (retry) {
@@ -123,6 +135,35 @@ Level::save(const std::string& filepath, bool retry)
   }
 }
 
+void
+Level::save(std::ostream& stream)
+{
+  Writer writer(&stream);
+  writer.start_list("supertux-level");
+  // Starts writing to supertux level file. Keep this at the very beginning.
+
+  writer.write("version", 2);
+  writer.write("name", m_name, true);
+  writer.write("author", m_author, false);
+  writer.write("tileset", m_tileset, false);
+  if (m_contact != "") {
+    writer.write("contact", m_contact, false);
+  }
+  if (m_license != "") {
+    writer.write("license", m_license, false);
+  }
+  if (m_target_time != 0.0f){
+    writer.write("target-time", m_target_time);
+  }
+
+  for(auto& sector : m_sectors) {
+    sector->save(writer);
+  }
+
+  // Ends writing to supertux level file. Keep this at the very end.
+  writer.end_list("supertux-level");
+}
+
 void
 Level::add_sector(std::unique_ptr<Sector> sector)
 {
@@ -17,6 +17,8 @@
 #ifndef HEADER_SUPERTUX_SUPERTUX_LEVEL_HPP
 #define HEADER_SUPERTUX_SUPERTUX_LEVEL_HPP
 
+#include <ostream>
+
 #include "supertux/statistics.hpp"
 
 class ReaderMapping;
@@ -52,6 +54,9 @@ public:
   // saves to a levelfile
   void save(const std::string& filename, bool retry = false);
 
+  // writes the level in levelfile format to the stream
+  void save(std::ostream& stream);
+
   void add_sector(std::unique_ptr<Sector> sector);
   const std::string& get_name() const { return m_name; }
   const std::string& get_author() const { return m_author; }
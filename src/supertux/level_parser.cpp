@@ -19,12 +19,14 @@
 #include <physfs.h>
 #include <sstream>
 
+#include "object/tilemap.hpp"
 #include "supertux/level.hpp"
 #include "supertux/sector.hpp"
 #include "supertux/sector_parser.hpp"
 #include "util/log.hpp"
 #include "util/reader.hpp"
 #include "util/reader_document.hpp"
+#include "util/reader_document_cache.hpp"
 #include "util/reader_mapping.hpp"
 
 std::unique_ptr<Level>
@@ -90,7 +92,7 @@ LevelParser::load(const std::string& filepath)
   try {
     m_level.m_filename = filepath;
     register_translation_directory(filepath);
-    auto doc = ReaderDocument::from_file(filepath);
+    auto doc = ReaderDocumentCache::from_file(filepath);
     auto root = doc.get_root();
 
     if(root.get_name() != "supertux-level")
@@ -136,6 +138,14 @@ LevelParser::load(const std::string& filepath)
   }
 
   m_level.m_stats.init(m_level);
+
+  // the tile images are created on first use, better before the
+  // level starts than while it is played
+  for(size_t i = 0; i < m_level.get_sector_count(); ++i) {
+    for(const auto& tilemap : m_level.get_sector(i)->get_objects_by_type<TileMap>()) {
+      tilemap.prefetch_tiles();
+    }
+  }
 }
 
 void
@@ -23,6 +23,7 @@
 #include <SDL_ttf.h>
 #include <boost/filesystem.hpp>
 #include <boost/locale.hpp>
+#include <future>
 #include <physfs.h>
 #include <tinygettext/log.hpp>
 extern "C" {
@@ -67,12 +68,29 @@ extern "C" {
 #include "supertux/world.hpp"
 #include "util/file_system.hpp"
 #include "util/gettext.hpp"
+#include "util/job_pool.hpp"
+#include "util/log.hpp"
+#include "util/reader_document_cache.hpp"
 #include "video/sdl_surface_ptr.hpp"
 #include "video/sdl_surface.hpp"
 #include "video/ttf_surface_manager.hpp"
 #include "worldmap/worldmap.hpp"
 #include "worldmap/worldmap_screen.hpp"
 
+class LogSubsystem final
+{
+public:
+  LogSubsystem()
+  {
+    log_start_async();
+  }
+
+  ~LogSubsystem()
+  {
+    log_stop_async();
+  }
+};
+
 class ConfigSubsystem final
 {
 public:
@@ -299,6 +317,7 @@ public:
 
   ~PhysfsSubsystem()
   {
+    ReaderDocumentCache::finish_writes();
     PHYSFS_deinit();
   }
 };
@@ -374,6 +393,31 @@ Main::launch_game(const CommandLineArguments& args)
   SDLSubsystem sdl_subsystem;
   ConsoleBuffer console_buffer;
 
+  // The parts of the startup that need neither SDL nor OpenGL run on
+  // their own threads next to the video and resource setup, the main
+  // thread only waits for them once their result is needed.
+  // Translating a string blocks until the dictionary is loaded.
+  auto audio_task = std::async(std::launch::async, [] {
+      return std::make_unique<SoundManager>();
+    });
+  begin_dictionary_loading();
+  auto dictionary_task = std::async(std::launch::async, [] {
+      try
+      {
+        if (g_dictionary_manager)
+          g_dictionary_manager->get_dictionary();
+      }
+      catch(...)
+      {
+        end_dictionary_loading();
+        throw;
+      }
+      end_dictionary_loading();
+    });
+  auto addons_task = std::async(std::launch::async, [] {
+      return AddonManager::scan_archives("addons");
+    });
+
   timelog("controller");
   InputManager input_manager(g_config->keyboard_config, g_config->joystick_config);
 
@@ -385,12 +429,8 @@ Main::launch_game(const CommandLineArguments& args)
 
   TTFSurfaceManager ttf_surface_manager;
 
-  timelog("audio");
-  SoundManager sound_manager;
-  sound_manager.enable_sound(g_config->sound_enabled);
-  sound_manager.enable_music(g_config->music_enabled);
-  sound_manager.set_sound_volume(g_config->sound_volume);
-  sound_manager.set_music_volume(g_config->music_volume);
+  // filled in below, declared here to keep the order of destruction
+  std::unique_ptr<SoundManager> sound_manager;
 
   timelog("scripting");
   SquirrelVirtualMachine scripting(g_config->enable_script_debugger);
@@ -400,8 +440,16 @@ Main::launch_game(const CommandLineArguments& args)
   SpriteManager sprite_manager;
   Resources resources;
 
+  timelog("audio");
+  sound_manager = audio_task.get();
+  sound_manager->enable_sound(g_config->sound_enabled);
+  sound_manager->enable_music(g_config->music_enabled);
+  sound_manager->set_sound_volume(g_config->sound_volume);
+  sound_manager->set_music_volume(g_config->music_volume);
+
   timelog("addons");
-  AddonManager addon_manager("addons", g_config->addons);
+  dictionary_task.get();
+  AddonManager addon_manager("addons", g_config->addons, addons_task.get());
 
   Console console(console_buffer);
 
@@ -409,6 +457,7 @@ Main::launch_game(const CommandLineArguments& args)
 
   const auto default_savegame = std::make_unique<Savegame>(std::string());
 
+  JobPool job_pool;
   GameManager game_manager;
   ScreenManager screen_manager(*video_system);
 
@@ -471,7 +520,7 @@ Main::launch_game(const CommandLineArguments& args)
         editor->update(0);
         screen_manager.push_screen(std::move(editor));
         MenuManager::instance().clear_menu_stack();
-        sound_manager.stop_music(0.5);
+        sound_manager->stop_music(0.5);
       } else {
         log_warning << "Level " << *(g_config->edit_level) << " doesn't exist." << std::endl;
       }
@@ -506,6 +555,9 @@ Main::run(int argc, char** argv)
   // Make boost.filesystem use it
   boost::filesystem::path::imbue(std::locale());
 
+  // flushed on destruction, so it has to outlive the catch blocks below
+  LogSubsystem log_subsystem;
+
   int result = 0;
 
   try
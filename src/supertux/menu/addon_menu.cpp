@@ -21,6 +21,8 @@
 #include "addon/addon.hpp"
 #include "addon/addon_manager.hpp"
 #include "gui/dialog.hpp"
+#include "gui/item_action.hpp"
+#include "gui/item_toggle.hpp"
 #include "gui/menu_item.hpp"
 #include "gui/menu_manager.hpp"
 #include "supertux/menu/download_dialog.hpp"
@@ -174,6 +176,7 @@ AddonMenu::rebuild_menu()
   }
   else
   {
+    std::vector<int> ids;
     int idx = 0;
     for (const auto& addon_id : m_installed_addons)
     {
@@ -181,17 +184,24 @@ AddonMenu::rebuild_menu()
       m_addons_enabled[idx] = addon.is_enabled();
       if(addon_visible(addon))
       {
-        std::string text = generate_menu_item_text(addon);
-        add_toggle(MAKE_INSTALLED_MENU_ID(idx), text, &m_addons_enabled[idx]);
+        ids.push_back(MAKE_INSTALLED_MENU_ID(idx));
       }
       idx += 1;
     }
+
+    add_lazy_items(ids, [this](int id) -> std::unique_ptr<MenuItem>
+    {
+      int addon_idx = UNPACK_INSTALLED_MENU_ID(id);
+      const Addon& addon = m_addon_manager.get_installed_addon(m_installed_addons[addon_idx]);
+      return std::make_unique<ItemToggle>(generate_menu_item_text(addon), &m_addons_enabled[addon_idx], id);
+    });
   }
 
   add_hl();
 
   {
-    bool have_new_stuff = false;
+    std::vector<int> ids;
+    std::vector<bool> updates(m_repository_addons.size(), false);
     int idx = 0;
     for (const auto& addon_id : m_repository_addons)
     {
@@ -214,9 +224,8 @@ AddonMenu::rebuild_menu()
                     << std::endl;
           if(addon_visible(addon))
           {
-            std::string text = generate_menu_item_text(addon);
-            add_entry(MAKE_REPOSITORY_MENU_ID(idx), str(boost::format( _("Install %s *NEW*") ) % text));
-            have_new_stuff = true;
+            ids.push_back(MAKE_REPOSITORY_MENU_ID(idx));
+            updates[idx] = true;
           }
         }
       }
@@ -225,15 +234,28 @@ AddonMenu::rebuild_menu()
         // addon is not installed
         if(addon_visible(addon))
         {
-          std::string text = generate_menu_item_text(addon);
-          add_entry(MAKE_REPOSITORY_MENU_ID(idx), str(boost::format( _("Install %s") ) % text));
-          have_new_stuff = true;
+          ids.push_back(MAKE_REPOSITORY_MENU_ID(idx));
         }
       }
       idx += 1;
     }
 
-    if (!have_new_stuff && m_addon_manager.has_been_updated())
+    add_lazy_items(ids, [this, updates](int id) -> std::unique_ptr<MenuItem>
+    {
+      int addon_idx = UNPACK_REPOSITORY_MENU_ID(id);
+      const Addon& addon = m_addon_manager.get_repository_addon(m_repository_addons[addon_idx]);
+      std::string text = generate_menu_item_text(addon);
+      if (updates[addon_idx])
+      {
+        return std::make_unique<ItemAction>(str(boost::format( _("Install %s *NEW*") ) % text), id);
+      }
+      else
+      {
+        return std::make_unique<ItemAction>(str(boost::format( _("Install %s") ) % text), id);
+      }
+    });
+
+    if (ids.empty() && m_addon_manager.has_been_updated())
     {
       if(m_language_pack_mode)
       {
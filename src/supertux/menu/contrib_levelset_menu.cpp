@@ -31,7 +31,8 @@
 
 ContribLevelsetMenu::ContribLevelsetMenu(std::unique_ptr<World> world) :
   m_world(std::move(world)),
-  m_levelset()
+  m_levelset(),
+  m_levelset_state()
 {
   assert(m_world->is_levelset());
 
@@ -39,17 +40,24 @@ ContribLevelsetMenu::ContribLevelsetMenu(std::unique_ptr<World> world) :
 
   Savegame savegame(m_world->get_savegame_filename());
   savegame.load();
-  LevelsetState state = savegame.get_levelset_state(m_world->get_basedir());
+  m_levelset_state = savegame.get_levelset_state(m_world->get_basedir());
 
   add_label(m_world->get_title());
   add_hl();
 
-  for (int i = 0; i < m_levelset->get_num_levels(); ++i)
+  // getting the title means parsing the level, so only do that for
+  // the levels that actually get shown
+  std::vector<int> ids(m_levelset->get_num_levels());
+  for (int i = 0; i < static_cast<int>(ids.size()); ++i)
   {
-    std::string filename = m_levelset->get_level_filename(i);
+    ids[i] = i;
+  }
+  add_lazy_items(ids, [this](int id) -> std::unique_ptr<MenuItem>
+  {
+    std::string filename = m_levelset->get_level_filename(id);
     std::string full_filename = FileSystem::join(m_world->get_basedir(), filename);
     std::string title = GameManager::current()->get_level_name(full_filename);
-    LevelState level_state = state.get_level_state(filename);
+    LevelState level_state = m_levelset_state.get_level_state(filename);
 
     std::ostringstream out;
     if (level_state.solved)
@@ -60,8 +68,8 @@ ContribLevelsetMenu::ContribLevelsetMenu(std::unique_ptr<World> world) :
     {
       out << title << " [ ]";
     }
-    add_entry(i, out.str());
-  }
+    return std::make_unique<ItemAction>(out.str(), id);
+  });
 
   add_hl();
   add_back(_("Back"));
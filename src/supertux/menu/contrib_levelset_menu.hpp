@@ -18,6 +18,7 @@
 #define HEADER_SUPERTUX_SUPERTUX_MENU_CONTRIB_LEVELSET_MENU_HPP
 
 #include "gui/menu.hpp"
+#include "supertux/savegame.hpp"
 
 class Levelset;
 class World;
@@ -27,6 +28,7 @@ class ContribLevelsetMenu final : public Menu
 private:
   std::unique_ptr<World> m_world;
   std::unique_ptr<Levelset> m_levelset;
+  LevelsetState m_levelset_state;
 
 public:
   ContribLevelsetMenu(std::unique_ptr<World> current_world);
@@ -101,6 +101,7 @@ EditorSectorsMenu::delete_sector()
         MenuManager::instance().clear_menu_stack();
         for(auto i = level->m_sectors.begin(); i != level->m_sectors.end(); ++i) {
           if ( i->get() == Editor::current()->currentsector ) {
+            Editor::current()->get_undo_manager().clear();
             level->m_sectors.erase(i);
             break;
           }
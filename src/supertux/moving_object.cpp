@@ -24,7 +24,8 @@ MovingObject::MovingObject() :
   m_bbox(),
   m_movement(),
   m_group(COLGROUP_MOVING),
-  m_dest()
+  m_dest(),
+  m_previous_pos()
 {
 }
 
@@ -33,7 +34,8 @@ MovingObject::MovingObject(const ReaderMapping& reader) :
   m_bbox(),
   m_movement(),
   m_group(COLGROUP_MOVING),
-  m_dest()
+  m_dest(),
+  m_previous_pos()
 {
 }
 
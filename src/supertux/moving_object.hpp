@@ -192,6 +192,10 @@ private:
       This field holds the currently anticipated destination of the object
       during collision detection */
   Rectf m_dest;
+
+  /** The position at the start of the last update, Sector draws the
+      object between it and the current position */
+  Vector m_previous_pos;
 };
 
 #endif
@@ -178,7 +178,7 @@ PlayerStatus::draw(DrawingContext& context)
 
   if (coin_surface)
   {
-    context.color().draw_surface(coin_surface,
+    context.color().draw_surface(*coin_surface,
                                  Vector(static_cast<float>(context.get_width()) - BORDER_X - static_cast<float>(coin_surface->get_width()) - Resources::fixed_font->get_text_width(coins_text),
                                         BORDER_Y + 1.0f + (Resources::fixed_font->get_text_height(coins_text) + 5) * static_cast<float>(player_id)),
                                    LAYER_HUD);
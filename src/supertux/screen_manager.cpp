@@ -33,7 +33,9 @@
 #include "supertux/sector.hpp"
 #include "video/compositor.hpp"
 #include "video/drawing_context.hpp"
+#include "video/video_system.hpp"
 
+#include <algorithm>
 #include <stdio.h>
 
 /** don't skip more than every 2nd frame */
@@ -45,6 +47,7 @@ ScreenManager::ScreenManager(VideoSystem& video_system) :
   m_menu_manager(new MenuManager),
   m_speed(1.0),
   m_target_framerate(60.0f),
+  m_interpolation(1.0f),
   m_actions(),
   m_fps(0),
   m_screen_fade(),
@@ -122,6 +125,12 @@ ScreenManager::get_speed() const
   return m_speed;
 }
 
+float
+ScreenManager::get_interpolation() const
+{
+  return m_interpolation;
+}
+
 void
 ScreenManager::draw_fps(DrawingContext& context, float fps_fps)
 {
@@ -378,41 +387,46 @@ ScreenManager::handle_screen_switch()
 void
 ScreenManager::run()
 {
-  Uint32 last_ticks = 0;
-  Uint32 elapsed_ticks = 0;
+  const double counter_frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+  Uint64 last_counter = SDL_GetPerformanceCounter();
+
+  /** real time in seconds that hasn't been simulated yet */
+  double elapsed_time = 0.0;
 
   handle_screen_switch();
 
   while (!m_screen_stack.empty())
   {
-    Uint32 ticks = SDL_GetTicks();
-    elapsed_ticks += ticks - last_ticks;
-    last_ticks = ticks;
+    Uint64 counter = SDL_GetPerformanceCounter();
+    elapsed_time += static_cast<double>(counter - last_counter) / counter_frequency;
+    last_counter = counter;
 
-    /** ticks (as returned from SDL_GetTicks) per frame */
-    const Uint32 ticks_per_frame = static_cast<Uint32>(1000.0 / m_target_framerate * g_debug.get_game_speed_multiplier());
+    /** real time in seconds per logic step */
+    const double step_time = g_debug.get_game_speed_multiplier() / m_target_framerate;
 
-    if (elapsed_ticks > ticks_per_frame*4)
+    if (elapsed_time > step_time * 4)
     {
       // when the game loads up or levels are switched the
-      // elapsed_ticks grows extremely large, so we just ignore those
+      // elapsed_time grows extremely large, so we just ignore those
       // large time jumps
-      elapsed_ticks = 0;
+      elapsed_time = 0.0;
     }
 
-    if (elapsed_ticks < ticks_per_frame)
+    // without vsync nothing would hold back rendering, so frames are
+    // only drawn after a logic step then
+    const bool interpolate = g_config->frame_interpolation && m_video_system.get_vsync() != 0;
+
+    if (!interpolate && elapsed_time < step_time)
     {
-      Uint32 delay_ticks = ticks_per_frame - elapsed_ticks;
-      SDL_Delay(delay_ticks);
-      last_ticks += delay_ticks;
-      elapsed_ticks += delay_ticks;
+      SDL_Delay(static_cast<Uint32>((step_time - elapsed_time) * 1000.0));
+      continue;
     }
 
     int frames = 0;
 
-    while (elapsed_ticks >= ticks_per_frame && frames < MAX_FRAME_SKIP)
+    while (elapsed_time >= step_time && frames < MAX_FRAME_SKIP)
     {
-      elapsed_ticks -= ticks_per_frame;
+      elapsed_time -= step_time;
       float timestep = 1.0f / m_target_framerate;
       g_real_time += timestep;
       timestep *= m_speed;
@@ -423,6 +437,8 @@ ScreenManager::run()
       frames += 1;
     }
 
+    m_interpolation = interpolate ? static_cast<float>(std::min(elapsed_time / step_time, 1.0)) : 1.0f;
+
     if (!m_screen_stack.empty())
     {
       Compositor compositor(m_video_system);
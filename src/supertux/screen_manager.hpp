@@ -48,6 +48,10 @@ public:
   float get_speed() const;
   bool has_pending_fadeout() const;
 
+  /** How far the current frame is between the last two logic steps,
+      from 0 to 1, objects are drawn at their interpolated position */
+  float get_interpolation() const;
+
   // push new screen on screen_stack
   void push_screen(std::unique_ptr<Screen> screen, std::unique_ptr<ScreenFade> fade = {});
   void pop_screen(std::unique_ptr<ScreenFade> fade = {});
@@ -68,6 +72,7 @@ private:
 
   float m_speed;
   float m_target_framerate;
+  float m_interpolation;
 
   struct Action
   {
@@ -18,6 +18,7 @@
 
 #include <physfs.h>
 #include <algorithm>
+#include <math.h>
 
 #include "audio/sound_manager.hpp"
 #include "badguy/badguy.hpp"
@@ -31,7 +32,6 @@
 #include "object/gradient.hpp"
 #include "object/player.hpp"
 #include "object/portable.hpp"
-#include "object/pulsing_light.hpp"
 #include "object/smoke_cloud.hpp"
 #include "object/text_array_object.hpp"
 #include "object/text_object.hpp"
@@ -45,8 +45,10 @@
 #include "supertux/debug.hpp"
 #include "supertux/game_object_factory.hpp"
 #include "supertux/game_session.hpp"
+#include "supertux/globals.hpp"
 #include "supertux/level.hpp"
 #include "supertux/savegame.hpp"
+#include "supertux/screen_manager.hpp"
 #include "supertux/spawn_point.hpp"
 #include "supertux/tile.hpp"
 #include "util/file_system.hpp"
@@ -56,6 +58,24 @@
 
 Sector* Sector::s_current = nullptr;
 
+namespace {
+
+/** objects that moved further than this in a single update were put
+    there instead of moving there, they aren't interpolated */
+const float MAX_INTERPOLATION_DISTANCE = 64.0f;
+
+Vector interpolate_position(const Vector& from, const Vector& to, float alpha)
+{
+  const Vector delta = to - from;
+  if (fabsf(delta.x) > MAX_INTERPOLATION_DISTANCE ||
+      fabsf(delta.y) > MAX_INTERPOLATION_DISTANCE)
+    return to;
+
+  return from + delta * alpha;
+}
+
+} // namespace
+
 Sector::Sector(Level& parent) :
   m_level(parent),
   m_name(),
@@ -71,6 +91,11 @@ Sector::Sector(Level& parent) :
   m_foremost_layer(),
   m_squirrel_environment(new SquirrelEnvironment(SquirrelVirtualMachine::current()->get_vm(), "sector")),
   m_collision_system(new CollisionSystem(*this)),
+  m_update_time(-1.0f),
+  m_previous_translation(),
+  m_draw_positions(),
+  m_draw_offsets(),
+  m_players(),
   m_gravity(10.0),
   m_music(),
   m_spawnpoints(),
@@ -302,6 +327,14 @@ Sector::update(float dt_sec)
 {
   BIND_SECTOR(*this);
 
+  // remember where everything was, draw() interpolates from there
+  m_update_time = g_real_time;
+  m_previous_translation = m_camera->get_translation();
+  for (auto object : m_collision_system->get_moving_objects())
+  {
+    object->m_previous_pos = object->get_pos();
+  }
+
   m_squirrel_environment->update(dt_sec);
 
   m_player->check_bounds();
@@ -357,6 +390,7 @@ Sector::before_object_add(GameObject& object)
   auto movingobject = dynamic_cast<MovingObject*>(&object);
   if (movingobject)
   {
+    movingobject->m_previous_pos = movingobject->get_pos();
     m_collision_system->add(movingobject);
   }
 
@@ -382,6 +416,7 @@ Sector::before_object_add(GameObject& object)
       return false;
     }
     m_player = player_;
+    m_players.push_back(player_);
   }
 
   auto effect_ = dynamic_cast<DisplayEffect*>(&object);
@@ -415,6 +450,13 @@ Sector::before_object_remove(GameObject& object)
   if (moving_object) {
     m_collision_system->remove(moving_object);
   }
+  auto player_ = dynamic_cast<Player*>(&object);
+  if (player_) {
+    m_players.erase(std::find(m_players.begin(), m_players.end(), player_));
+    if (m_player == player_) {
+      m_player = nullptr;
+    }
+  }
 
   if(s_current == this)
     m_squirrel_environment->try_unexpose(object);
@@ -425,9 +467,46 @@ Sector::draw(DrawingContext& context)
 {
   BIND_SECTOR(*this);
 
+  // only draw between the last two updates when the last one was
+  // this sector's, a paused sector would jitter otherwise
+  const float alpha = (m_update_time == g_real_time) ? ScreenManager::current()->get_interpolation() : 1.0f;
+  const bool interpolate = alpha < 1.0f;
+
+  const auto& moving_objects = m_collision_system->get_moving_objects();
+  if (interpolate)
+  {
+    m_draw_positions.clear();
+    for (auto object : moving_objects)
+    {
+      m_draw_positions.push_back(object->get_pos());
+      object->m_bbox.set_pos(interpolate_position(object->m_previous_pos, object->get_pos(), alpha));
+    }
+
+    // tilemaps following a path carry objects standing on them, so
+    // they have to be drawn between the steps as well
+    m_draw_offsets.clear();
+    for (auto& tilemap : get_objects_by_type<TileMap>())
+    {
+      const Vector movement = tilemap.get_movement(true);
+      if (movement.x == 0.0f && movement.y == 0.0f)
+        continue;
+
+      const Vector offset = tilemap.get_offset();
+      m_draw_offsets.emplace_back(&tilemap, offset);
+      tilemap.set_offset(interpolate_position(offset - movement, offset, alpha));
+    }
+  }
+
   context.set_ambient_color( m_ambient_light );
   context.push_transform();
-  context.set_translation(m_camera->get_translation());
+  if (interpolate)
+  {
+    context.set_translation(interpolate_position(m_previous_translation, m_camera->get_translation(), alpha));
+  }
+  else
+  {
+    context.set_translation(m_camera->get_translation());
+  }
 
   GameObjectManager::draw(context);
 
@@ -436,6 +515,18 @@ Sector::draw(DrawingContext& context)
   }
 
   context.pop_transform();
+
+  if (interpolate)
+  {
+    for (size_t i = 0; i < moving_objects.size(); ++i)
+    {
+      moving_objects[i]->m_bbox.set_pos(m_draw_positions[i]);
+    }
+    for (const auto& draw_offset : m_draw_offsets)
+    {
+      draw_offset.first->set_offset(draw_offset.second);
+    }
+  }
 }
 
 bool
@@ -462,11 +553,16 @@ Sector::free_line_of_sight(const Vector& line_start, const Vector& line_end, con
   return m_collision_system->free_line_of_sight(line_start, line_end, ignore_object);
 }
 
+void
+Sector::probe_tiles(std::vector<collision::TileProbe>& probes) const
+{
+  m_collision_system->probe_tiles(probes);
+}
+
 bool
 Sector::can_see_player(const Vector& eye) const
 {
-  const std::vector<Player*> players = get_players();
-  for (const auto& pl : players) {
+  for (const auto& pl : m_players) {
     // test for free line of sight to any of all four corners and the middle of the player's bounding box
     if (free_line_of_sight(eye, pl->get_bbox().p1, pl)) return true;
     if (free_line_of_sight(eye, Vector(pl->get_bbox().p2.x, pl->get_bbox().p1.y), pl)) return true;
@@ -666,8 +762,7 @@ Sector::get_nearest_player (const Vector& pos) const
   Player *nearest_player = nullptr;
   float nearest_dist = std::numeric_limits<float>::max();
 
-  std::vector<Player*> players = get_players();
-  for (auto& this_player : players)
+  for (auto& this_player : m_players)
   {
     if (this_player->is_dying() || this_player->is_dead())
       continue;
@@ -683,12 +778,6 @@ Sector::get_nearest_player (const Vector& pos) const
   return nearest_player;
 } /* Player *get_nearest_player */
 
-std::vector<MovingObject*>
-Sector::get_nearby_objects (const Vector& center, float max_distance) const
-{
-  return m_collision_system->get_nearby_objects(center, max_distance);
-}
-
 void
 Sector::stop_looping_sounds()
 {
@@ -751,9 +840,12 @@ Sector::get_moving_objects() const
 void
 Sector::convert_tiles2gameobject()
 {
-  // add lights for special tiles
   for(auto& tm : get_objects_by_type<TileMap>())
   {
+    // lights for fire and lava tiles are drawn by the tilemap itself
+    tm.enable_tile_lights();
+
+    tm.begin_changes();
     for(int x=0; x < tm.get_width(); ++x)
     {
       for(int y=0; y < tm.get_height(); ++y)
@@ -777,33 +869,9 @@ Sector::convert_tiles2gameobject()
             }
           }
         }
-        else
-        {
-          // add lights for fire tiles
-          uint32_t attributes = tile.get_attributes();
-          Vector pos = tm.get_tile_position(x, y);
-          Vector center = pos + Vector(16, 16);
-
-          if (attributes & Tile::FIRE) {
-            if (attributes & Tile::HURTS) {
-              // lava or lavaflow
-              // space lights a bit
-              if ((tm.get_tile(x-1, y).get_attributes() != attributes || x%3 == 0)
-                  && (tm.get_tile(x, y-1).get_attributes() != attributes || y%3 == 0)) {
-                float pseudo_rnd = static_cast<float>(static_cast<int>(pos.x) % 10) / 10;
-                add<PulsingLight>(center, 1.0f + pseudo_rnd, 0.8f, 1.0f,
-                                  Color(1.0f, 0.3f, 0.0f, 1.0f));
-              }
-            } else {
-              // torch
-              float pseudo_rnd = static_cast<float>(static_cast<int>(pos.x) % 10) / 10;
-              add<PulsingLight>(center, 1.0f + pseudo_rnd, 0.9f, 1.0f,
-                                Color(1.0f, 1.0f, 0.6f, 1.0f));
-            }
-          }
-        }
       }
     }
+    tm.end_changes();
   }
 }
 
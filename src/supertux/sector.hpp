@@ -17,22 +17,24 @@
 #ifndef HEADER_SUPERTUX_SUPERTUX_SECTOR_HPP
 #define HEADER_SUPERTUX_SUPERTUX_SECTOR_HPP
 
+#include <utility>
 #include <vector>
 #include <stdint.h>
 
 #include "object/anchor_point.hpp"
 #include "squirrel/squirrel_environment.hpp"
+#include "supertux/collision_system.hpp"
 #include "supertux/d_scope.hpp"
 #include "supertux/game_object_manager.hpp"
 #include "video/color.hpp"
 
 namespace collision {
 class Constraints;
+class TileProbe;
 }
 
 class Bullet;
 class Camera;
-class CollisionSystem;
 class DisplayEffect;
 class DrawingContext;
 class Level;
@@ -129,18 +131,28 @@ public:
   bool is_free_of_movingstatics(const Rectf& rect, const MovingObject* ignore_object = nullptr) const;
 
   bool free_line_of_sight(const Vector& line_start, const Vector& line_end, const MovingObject* ignore_object = nullptr) const;
+
+  /** Resolves a batch of point probes against the solid tilemaps,
+      see CollisionSystem::probe_tiles() */
+  void probe_tiles(std::vector<collision::TileProbe>& probes) const;
   bool can_see_player(const Vector& eye) const;
 
-  /** returns a list of players currently in the sector */
-  std::vector<Player*> get_players() const {
-    return std::vector<Player*>(1, m_player);
+  /** returns the players currently in the sector, the list is kept
+      up to date as players are added and removed */
+  const std::vector<Player*>& get_players() const {
+    return m_players;
   }
   Player* get_nearest_player (const Vector& pos) const;
   Player* get_nearest_player (const Rectf& pos) const {
     return (get_nearest_player (get_anchor_pos (pos, ANCHOR_MIDDLE)));
   }
 
-  std::vector<MovingObject*> get_nearby_objects (const Vector& center, float max_distance) const;
+  /** Calls func(object, distance) for the moving objects near center,
+      see CollisionSystem::for_each_nearby_object() */
+  template<typename F>
+  void for_each_nearby_object(const Vector& center, float max_distance, uint32_t group_mask, F func) const {
+    m_collision_system->for_each_nearby_object(center, max_distance, group_mask, func);
+  }
 
   Rectf get_active_region() const;
 
@@ -193,7 +205,7 @@ private:
   int calculate_foremost_layer() const;
 
   /** Convert tiles into their corresponding GameObjects (e.g.
-      bonusblocks, add light to lava tiles) */
+      bonusblocks) and let tilemaps light up fire and lava tiles */
   void convert_tiles2gameobject();
 
 private:
@@ -230,6 +242,17 @@ private:
   std::unique_ptr<SquirrelEnvironment> m_squirrel_environment;
   std::unique_ptr<CollisionSystem> m_collision_system;
 
+  /** g_real_time of the last update and the camera translation from
+      before it, draw() uses them to draw between the last two updates */
+  float m_update_time;
+  Vector m_previous_translation;
+
+  /** reused by draw() to put interpolated objects back */
+  std::vector<Vector> m_draw_positions;
+  std::vector<std::pair<TileMap*, Vector> > m_draw_offsets;
+
+  std::vector<Player*> m_players;
+
   float m_gravity;
   std::string m_music;
 
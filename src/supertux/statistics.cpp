@@ -211,7 +211,7 @@ Statistics::draw_endseq_panel(DrawingContext& context, Statistics* best_stats, S
 
   context.push_transform();
   context.set_alpha(0.5f);
-  context.color().draw_surface(backdrop, Vector(static_cast<float>(bd_x), static_cast<float>(bd_y)), LAYER_HUD);
+  context.color().draw_surface(*backdrop, Vector(static_cast<float>(bd_x), static_cast<float>(bd_y)), LAYER_HUD);
   context.pop_transform();
 
   context.color().draw_text(Resources::normal_font, _("You"), Vector(col2_x, row1_y), ALIGN_LEFT, LAYER_HUD, Statistics::header_color);
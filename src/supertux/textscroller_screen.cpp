@@ -145,7 +145,7 @@ TextScrollerScreen::draw(Compositor& compositor)
     if (bg_ratio > ctx_ratio)
     {
       const float new_bg_w = ctx_h * bg_ratio;
-      context.color().draw_surface_scaled(m_background,
+      context.color().draw_surface_scaled(*m_background,
                                           Rectf::from_center(Vector(ctx_w / 2.0f, ctx_h / 2.0f),
                                                              Sizef(new_bg_w, ctx_h)),
                                           0);
@@ -153,7 +153,7 @@ TextScrollerScreen::draw(Compositor& compositor)
     else
     {
       const float new_bg_h = ctx_w / bg_ratio;
-      context.color().draw_surface_scaled(m_background,
+      context.color().draw_surface_scaled(*m_background,
                                           Rectf::from_center(Vector(ctx_w / 2.0f, ctx_h / 2.0f),
                                                              Sizef(ctx_w, new_bg_h)),
                                           0);
@@ -18,6 +18,8 @@
 
 #include "supertux/tile.hpp"
 
+#include <stdexcept>
+
 #include "math/aatriangle.hpp"
 #include "supertux/constants.hpp"
 #include "supertux/globals.hpp"
@@ -47,6 +49,7 @@ bool is_below_line (float l_x, float l_y, float m,
 Tile::Tile() :
   m_images(),
   m_editor_images(),
+  m_image_loader(),
   m_attributes(0),
   m_data(0),
   m_fps(1),
@@ -62,6 +65,23 @@ Tile::Tile(const std::vector<SurfacePtr>& images,
            const std::string& obj_data, bool deprecated) :
   m_images(images),
   m_editor_images(editor_images),
+  m_image_loader(),
+  m_attributes(attributes_),
+  m_data(data_),
+  m_fps(fps_),
+  m_object_name(obj_name),
+  m_object_data(obj_data),
+  m_deprecated(deprecated)
+{
+  correct_attributes();
+}
+
+Tile::Tile(const ImageLoader& image_loader,
+           uint32_t attributes_, uint32_t data_, float fps_, const std::string& obj_name,
+           const std::string& obj_data, bool deprecated) :
+  m_images(),
+  m_editor_images(),
+  m_image_loader(image_loader),
   m_attributes(attributes_),
   m_data(data_),
   m_fps(fps_),
@@ -72,38 +92,64 @@ Tile::Tile(const std::vector<SurfacePtr>& images,
   correct_attributes();
 }
 
+void
+Tile::load_images() const
+{
+  if (!m_image_loader)
+    return;
+
+  // a loader that fails isn't tried again on every draw
+  ImageLoader loader = std::move(m_image_loader);
+  m_image_loader = nullptr;
+
+  try
+  {
+    loader(m_images, m_editor_images);
+  }
+  catch(const std::exception& err)
+  {
+    log_warning << "Couldn't load tile images: " << err.what() << std::endl;
+    m_images.clear();
+    m_editor_images.clear();
+  }
+}
+
 void
 Tile::draw(Canvas& canvas, const Vector& pos, int z_pos, Color color) const
 {
+  load_images();
+
   if(draw_editor_images) {
     if(m_editor_images.size() > 1) {
       size_t frame = size_t(g_game_time * m_fps) % m_editor_images.size();
-      canvas.draw_surface(m_editor_images[frame], pos, 0, color, Blend(), z_pos);
+      canvas.draw_surface(*m_editor_images[frame], pos, 0, color, Blend(), z_pos);
       return;
     } else if (m_editor_images.size() == 1) {
-      canvas.draw_surface(m_editor_images[0], pos, 0, color, Blend(), z_pos);
+      canvas.draw_surface(*m_editor_images[0], pos, 0, color, Blend(), z_pos);
       return;
     }
   }
 
   if(m_images.size() > 1) {
     size_t frame = size_t(g_game_time * m_fps) % m_images.size();
-    canvas.draw_surface(m_images[frame], pos, 0, color, Blend(), z_pos);
+    canvas.draw_surface(*m_images[frame], pos, 0, color, Blend(), z_pos);
   } else if (m_images.size() == 1) {
-    canvas.draw_surface(m_images[0], pos, 0, color, Blend(), z_pos);
+    canvas.draw_surface(*m_images[0], pos, 0, color, Blend(), z_pos);
   }
 }
 
-SurfacePtr
+const Surface*
 Tile::get_current_surface() const
 {
+  load_images();
+
   if(m_images.size() > 1) {
     size_t frame = size_t(g_game_time * m_fps) % m_images.size();
-    return m_images[frame];
+    return m_images[frame].get();
   } else if (m_images.size() == 1) {
-    return m_images[0];
+    return m_images[0].get();
   } else {
-    return {};
+    return nullptr;
   }
 }
 
@@ -19,6 +19,7 @@
 #ifndef HEADER_SUPERTUX_SUPERTUX_TILE_HPP
 #define HEADER_SUPERTUX_SUPERTUX_TILE_HPP
 
+#include <functional>
 #include <vector>
 #include <stdint.h>
 
@@ -33,6 +34,11 @@ class Tile final
 {
 public:
   static bool draw_editor_images;
+
+  /** Creates the images and the editor images of a tile */
+  using ImageLoader = std::function<void (std::vector<SurfacePtr>& images,
+                                          std::vector<SurfacePtr>& editor_images)>;
+
   /// bitset for tile attributes
   enum {
     /** solid tile that is indestructible by Tux */
@@ -94,8 +100,11 @@ public:
   };
 
 private:
-  std::vector<SurfacePtr> m_images;
-  std::vector<SurfacePtr> m_editor_images;
+  mutable std::vector<SurfacePtr> m_images;
+  mutable std::vector<SurfacePtr> m_editor_images;
+
+  /** set until the images are created on their first use */
+  mutable ImageLoader m_image_loader;
 
   /// tile attributes
   uint32_t m_attributes;
@@ -116,11 +125,20 @@ public:
        const std::vector<SurfacePtr>& editor_images,
        uint32_t attributes, uint32_t data, float fps, const std::string& obj_name = "",
        const std::string& obj_data = "", bool deprecated = false);
+  Tile(const ImageLoader& image_loader,
+       uint32_t attributes, uint32_t data, float fps, const std::string& obj_name = "",
+       const std::string& obj_data = "", bool deprecated = false);
+
+  /** Creates the images if that didn't happen yet, drawing the tile
+      does this on its own */
+  void load_images() const;
 
   /** Draw a tile on the screen */
   void draw(Canvas& canvas, const Vector& pos, int z_pos, Color color = Color(1, 1, 1)) const;
 
-  SurfacePtr get_current_surface() const;
+  /** Returns the surface of the current frame or nullptr, the
+      surface is owned by the tile */
+  const Surface* get_current_surface() const;
 
   uint32_t get_attributes() const
   { return m_attributes; }
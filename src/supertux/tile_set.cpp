@@ -22,6 +22,7 @@
 #include "supertux/tile_set_parser.hpp"
 #include "util/gettext.hpp"
 #include "util/log.hpp"
+#include "util/reader_document.hpp"
 #include "video/drawing_context.hpp"
 #include "video/surface.hpp"
 
@@ -46,22 +47,40 @@ TileSet::from_file(const std::string& filename)
 }
 
 TileSet::TileSet() :
+  m_document(),
   m_tiles(1),
+  m_attributes(1, 0),
+  m_data(1, 0),
   m_tilegroups()
 {
   m_tiles[0] = std::make_unique<Tile>();
 }
 
+TileSet::~TileSet()
+{
+}
+
+const ReaderDocument&
+TileSet::keep_document(const ReaderDocument& doc)
+{
+  m_document = std::make_unique<ReaderDocument>(doc);
+  return *m_document;
+}
+
 void
 TileSet::add_tile(int id, std::unique_ptr<Tile> tile)
 {
   if (id >= static_cast<int>(m_tiles.size())) {
     m_tiles.resize(id + 1);
+    m_attributes.resize(id + 1, 0);
+    m_data.resize(id + 1, 0);
   }
 
   if (m_tiles[id]) {
     log_warning << "Tile with ID " << id << " redefined" << std::endl;
   } else {
+    m_attributes[id] = tile->get_attributes();
+    m_data[id] = tile->get_data();
     m_tiles[id] = std::move(tile);
   }
 }
@@ -84,6 +103,23 @@ TileSet::get(const uint32_t id) const
   }
 }
 
+void
+TileSet::prefetch(const std::vector<uint32_t>& ids) const
+{
+  std::vector<bool> done(m_tiles.size());
+  for(const auto id : ids)
+  {
+    if (id < m_tiles.size() && !done[id])
+    {
+      done[id] = true;
+      if (m_tiles[id])
+      {
+        m_tiles[id]->load_images();
+      }
+    }
+  }
+}
+
 void
 TileSet::add_unassigned_tilegroup()
 {
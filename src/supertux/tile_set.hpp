@@ -20,12 +20,14 @@
 #include <memory>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 #include "video/color.hpp"
 #include "video/surface_ptr.hpp"
 
 class Canvas;
 class DrawingContext;
+class ReaderDocument;
 class Tile;
 class Vector;
 
@@ -46,9 +48,18 @@ public:
 
 public:
   TileSet();
+  ~TileSet();
+
+  /** Keeps the parsed tileset file around, the tiles create their
+      images from it when they are needed */
+  const ReaderDocument& keep_document(const ReaderDocument& doc);
 
   void add_tile(int id, std::unique_ptr<Tile> tile);
 
+  /** Creates the images of the given tiles now instead of on their
+      first draw, ids may repeat */
+  void prefetch(const std::vector<uint32_t>& ids) const;
+
   /** Adds a group of tiles that haven't
       been assigned to any other group */
   void add_unassigned_tilegroup();
@@ -57,6 +68,22 @@ public:
 
   const Tile& get(const uint32_t id) const;
 
+  /** The attributes and data of the tiles are also kept in arrays
+      indexed by tile id, so that loops over many tiles, like the
+      collision detection, don't have to visit each Tile. Unknown ids
+      behave like tile 0. */
+  uint32_t get_attributes(uint32_t id) const {
+    return id < m_attributes.size() ? m_attributes[id] : 0;
+  }
+
+  int get_data(uint32_t id) const {
+    return id < m_data.size() ? m_data[id] : 0;
+  }
+
+  const std::vector<uint32_t>& get_attributes() const {
+    return m_attributes;
+  }
+
   uint32_t get_max_tileid() const {
     return static_cast<uint32_t>(m_tiles.size());
   }
@@ -68,7 +95,10 @@ public:
   void print_debug_info(const std::string& filename);
 
 private:
+  std::unique_ptr<ReaderDocument> m_document;
   std::vector<std::unique_ptr<Tile> > m_tiles;
+  std::vector<uint32_t> m_attributes;
+  std::vector<int> m_data;
   std::vector<Tilegroup> m_tilegroups;
 
 private:
@@ -42,7 +42,9 @@ TileSetParser::parse()
 {
   m_tiles_path = FileSystem::dirname(m_filename);
 
-  auto doc = ReaderDocument::from_file(m_filename);
+  // the tiles read their images from the document when they are
+  // first drawn, so the tileset has to keep it
+  const ReaderDocument& doc = m_tileset.keep_document(ReaderDocument::from_file(m_filename));
   auto root = doc.get_root();
 
   if(root.get_name() != "supertux-tiles") {
@@ -142,22 +144,16 @@ TileSetParser::parse_tile(const ReaderMapping& reader)
     attributes |= Tile::SOLID | Tile::SLOPE;
   }
 
-  std::vector<SurfacePtr> editor_surfaces;
   boost::optional<ReaderMapping> editor_images_mapping;
-  if(reader.get("editor-images", editor_images_mapping)) {
-    editor_surfaces = parse_imagespecs(*editor_images_mapping);
-  }
+  reader.get("editor-images", editor_images_mapping);
 
-  std::vector<SurfacePtr> surfaces;
   boost::optional<ReaderMapping> images_mapping;
-  if(reader.get("images", images_mapping)) {
-    surfaces = parse_imagespecs(*images_mapping);
-  }
+  reader.get("images", images_mapping);
 
   bool deprecated = false;
   reader.get("deprecated", deprecated);
 
-  auto tile = std::make_unique<Tile>(surfaces, editor_surfaces,
+  auto tile = std::make_unique<Tile>(make_image_loader(images_mapping, editor_images_mapping),
                                      attributes, data, fps,
                                      object_name, object_data, deprecated);
   m_tileset.add_tile(id, std::move(tile));
@@ -190,9 +186,6 @@ TileSetParser::parse_tiles(const ReaderMapping& reader)
   reader.get("width", width);
   reader.get("height", height);
 
-  bool shared_surface = false;
-  reader.get("shared-surface", shared_surface);
-
   float fps = 10;
   reader.get("fps",     fps);
 
@@ -236,89 +229,71 @@ TileSetParser::parse_tiles(const ReaderMapping& reader)
   }
   else
   {
-    if (shared_surface)
+    boost::optional<ReaderMapping> surfaces_mapping;
+    if (!reader.get("image", surfaces_mapping))
     {
-      std::vector<SurfacePtr> editor_surfaces;
-      boost::optional<ReaderMapping> editor_surfaces_mapping;
-      if(reader.get("editor-images", editor_surfaces_mapping)) {
-        editor_surfaces = parse_imagespecs(*editor_surfaces_mapping);
-      }
+      reader.get("images", surfaces_mapping);
+    }
 
-      std::vector<SurfacePtr> surfaces;
-      boost::optional<ReaderMapping> surfaces_mapping;
-      if(reader.get("image", surfaces_mapping) ||
-         reader.get("images", surfaces_mapping)) {
-        surfaces = parse_imagespecs(*surfaces_mapping);
-      }
+    boost::optional<ReaderMapping> editor_surfaces_mapping;
+    reader.get("editor-images", editor_surfaces_mapping);
 
-      for(size_t i = 0; i < ids.size(); ++i)
+    // Every tile takes its own region of the images, with or without
+    // "shared-surface", as regions of one file share their texture.
+    for(size_t i = 0; i < ids.size(); ++i)
+    {
+      if (ids[i] != 0)
       {
-        if (ids[i] != 0)
-        {
-          int x = static_cast<int>(32 * (i % width));
-          int y = static_cast<int>(32 * (i / width));
-
-          std::vector<SurfacePtr> regions;
-          std::vector<SurfacePtr> editor_regions;
+        int x = static_cast<int>(32 * (i % width));
+        int y = static_cast<int>(32 * (i / width));
 
-          for(const auto& surface : surfaces)
-          {
-            regions.push_back(surface->region(Rect(x, y, Size(32, 32))));
-          }
+        auto tile = std::make_unique<Tile>(make_image_loader(surfaces_mapping, editor_surfaces_mapping,
+                                                             Rect(x, y, Size(32, 32))),
+                                           (has_attributes ? attributes[i] : 0),
+                                           (has_datas ? datas[i] : 0),
+                                           fps);
 
-          for(const auto& surface : editor_surfaces)
-          {
-            editor_regions.push_back(surface->region(Rect(x, y, Size(32, 32))));
-          }
+        m_tileset.add_tile(ids[i], std::move(tile));
+      }
+    }
+  }
+}
 
-          auto tile = std::make_unique<Tile>(regions,
-                                             editor_regions,
-                                             (has_attributes ? attributes[i] : 0),
-                                             (has_datas ? datas[i] : 0),
-                                             fps);
+Tile::ImageLoader
+TileSetParser::make_image_loader(const boost::optional<ReaderMapping>& images,
+                                 const boost::optional<ReaderMapping>& editor_images,
+                                 const boost::optional<Rect>& region) const
+{
+  // the mappings point into the document kept by the TileSet
+  const ReaderDocument* doc = images ? &images->get_doc() :
+    editor_images ? &editor_images->get_doc() : nullptr;
+  const sexp::Value* images_sx = images ? &images->get_sexp() : nullptr;
+  const sexp::Value* editor_images_sx = editor_images ? &editor_images->get_sexp() : nullptr;
+  const std::string tiles_path = m_tiles_path;
+
+  if (!doc)
+  {
+    return {};
+  }
 
-          m_tileset.add_tile(ids[i], std::move(tile));
-        }
-      }
+  return [doc, images_sx, editor_images_sx, tiles_path, region]
+    (std::vector<SurfacePtr>& surfaces, std::vector<SurfacePtr>& editor_surfaces)
+  {
+    if (images_sx)
+    {
+      surfaces = parse_imagespecs(ReaderMapping(*doc, *images_sx), tiles_path, region);
     }
-    else // (!shared_surface)
+    if (editor_images_sx)
     {
-      for(size_t i = 0; i < ids.size(); ++i)
-      {
-        if (ids[i] != 0)
-        {
-          int x = static_cast<int>(32 * (i % width));
-          int y = static_cast<int>(32 * (i / width));
-
-          std::vector<SurfacePtr> surfaces;
-          boost::optional<ReaderMapping> surfaces_mapping;
-          if(reader.get("image", surfaces_mapping) ||
-             reader.get("images", surfaces_mapping)) {
-            surfaces = parse_imagespecs(*surfaces_mapping, Rect(x, y, Size(32, 32)));
-          }
-
-          std::vector<SurfacePtr> editor_surfaces;
-          boost::optional<ReaderMapping> editor_surfaces_mapping;
-          if(reader.get("editor-images", editor_surfaces_mapping)) {
-            editor_surfaces = parse_imagespecs(*editor_surfaces_mapping, Rect(x, y, Size(32, 32)));
-          }
-
-          auto tile = std::make_unique<Tile>(surfaces,
-                                             editor_surfaces,
-                                             (has_attributes ? attributes[i] : 0),
-                                             (has_datas ? datas[i] : 0),
-                                             fps);
-
-          m_tileset.add_tile(ids[i], std::move(tile));
-        }
-      }
+      editor_surfaces = parse_imagespecs(ReaderMapping(*doc, *editor_images_sx), tiles_path, region);
     }
-  }
+  };
 }
 
 std::vector<SurfacePtr>
   TileSetParser::parse_imagespecs(const ReaderMapping& images_lisp,
-                                  const boost::optional<Rect>& surface_region) const
+                                  const std::string& tiles_path,
+                                  const boost::optional<Rect>& surface_region)
 {
   std::vector<SurfacePtr> surfaces;
 
@@ -330,7 +305,7 @@ std::vector<SurfacePtr>
     if(iter.is_string())
     {
       std::string file = iter.as_string_item();
-      surfaces.push_back(Surface::from_file(FileSystem::join(m_tiles_path, file), surface_region));
+      surfaces.push_back(Surface::from_file(FileSystem::join(tiles_path, file), surface_region));
     }
     else if(iter.is_pair() && iter.get_key() == "surface")
     {
@@ -363,7 +338,7 @@ std::vector<SurfacePtr>
           rect.bottom = rect.top + surface_region->get_height();
         }
 
-        surfaces.push_back(Surface::from_file(FileSystem::join(m_tiles_path, file),
+        surfaces.push_back(Surface::from_file(FileSystem::join(tiles_path, file),
                                               rect));
       }
     }
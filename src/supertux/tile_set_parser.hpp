@@ -43,8 +43,17 @@ public:
 private:
   void parse_tile(const ReaderMapping& reader);
   void parse_tiles(const ReaderMapping& reader);
-  std::vector<SurfacePtr> parse_imagespecs(const ReaderMapping& cur,
-                                           const boost::optional<Rect>& region = boost::none) const;
+
+  /** Returns a loader that creates the tile images from the given
+      images and editor-images sections on first use, either may be
+      missing */
+  Tile::ImageLoader make_image_loader(const boost::optional<ReaderMapping>& images,
+                                      const boost::optional<ReaderMapping>& editor_images,
+                                      const boost::optional<Rect>& region = boost::none) const;
+
+  static std::vector<SurfacePtr> parse_imagespecs(const ReaderMapping& cur,
+                                                  const std::string& tiles_path,
+                                                  const boost::optional<Rect>& region = boost::none);
 
 private:
   TileSetParser(const TileSetParser&) = delete;
@@ -108,7 +108,7 @@ TitleScreen::draw(Compositor& compositor)
   Sector* sector  = titlesession->get_current_sector();
   sector->draw(context);
 
-  context.color().draw_surface_scaled(frame,
+  context.color().draw_surface_scaled(*frame,
                                       Rectf(0, 0, static_cast<float>(context.get_width()), static_cast<float>(context.get_height())),
                                       LAYER_FOREGROUND1);
 
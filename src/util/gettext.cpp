@@ -16,6 +16,43 @@
 
 #include "util/gettext.hpp"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
 std::unique_ptr<tinygettext::DictionaryManager> g_dictionary_manager = nullptr;
 
+namespace {
+
+std::atomic<bool> g_dictionary_loading(false);
+std::mutex g_dictionary_mutex;
+std::condition_variable g_dictionary_loaded;
+
+} // namespace
+
+void begin_dictionary_loading()
+{
+  g_dictionary_loading.store(true, std::memory_order_release);
+}
+
+void end_dictionary_loading()
+{
+  {
+    std::lock_guard<std::mutex> lock(g_dictionary_mutex);
+    g_dictionary_loading.store(false, std::memory_order_release);
+  }
+  g_dictionary_loaded.notify_all();
+}
+
+void wait_for_dictionary()
+{
+  if (!g_dictionary_loading.load(std::memory_order_acquire))
+    return;
+
+  std::unique_lock<std::mutex> lock(g_dictionary_mutex);
+  g_dictionary_loaded.wait(lock, [] {
+      return !g_dictionary_loading.load(std::memory_order_acquire);
+    });
+}
+
 /* EOF */
@@ -22,6 +22,15 @@
 
 extern std::unique_ptr<tinygettext::DictionaryManager> g_dictionary_manager;
 
+/** The dictionary may be loaded on another thread while the game
+    starts up. Everything that uses g_dictionary_manager has to call
+    wait_for_dictionary() first, it blocks between
+    begin_dictionary_loading() and end_dictionary_loading() and only
+    costs an atomic load otherwise. */
+void begin_dictionary_loading();
+void end_dictionary_loading();
+void wait_for_dictionary();
+
 /*
  * If you need to do a nontrivial substitution of values into a pattern, use
  * boost::format rather than an ad-hoc concatenation.  That way, translators can
@@ -55,6 +64,7 @@ extern std::unique_ptr<tinygettext::DictionaryManager> g_dictionary_manager;
 
 static inline std::string _(const std::string& message)
 {
+  wait_for_dictionary();
   if (g_dictionary_manager)
   {
     return g_dictionary_manager->get_dictionary().translate(message);
@@ -68,6 +78,7 @@ static inline std::string _(const std::string& message)
 static inline std::string __(const std::string& message,
     const std::string& message_plural, int num)
 {
+  wait_for_dictionary();
   if (g_dictionary_manager)
   {
     return g_dictionary_manager->get_dictionary().translate_plural(message,
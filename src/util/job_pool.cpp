@@ -0,0 +1,223 @@
+//  SuperTux
+//  Copyright (C) 2018 Ingo Ruhnke <grumbel@gmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "util/job_pool.hpp"
+
+#include <algorithm>
+
+namespace {
+
+/** beyond this the jobs are usually too small to gain anything */
+const int MAX_JOB_WORKERS = 7;
+
+/** chunks dealt out per thread, more make stealing more effective
+    but cost more locking */
+const size_t CHUNKS_PER_THREAD = 4;
+
+int default_worker_count()
+{
+  const int cores = static_cast<int>(std::thread::hardware_concurrency());
+  return std::max(cores - 1, 0);
+}
+
+} // namespace
+
+JobPool::JobPool() :
+  JobPool(default_worker_count())
+{
+}
+
+JobPool::JobPool(int num_workers) :
+  m_workers(),
+  m_queues(),
+  m_mutex(),
+  m_wake(),
+  m_done(),
+  m_generation(0),
+  m_quit(false),
+  m_job(nullptr),
+  m_count(0),
+  m_chunk_size(0),
+  m_remaining(0),
+  m_exception()
+{
+  num_workers = std::min(std::max(num_workers, 0), MAX_JOB_WORKERS);
+
+  for (int i = 0; i < num_workers + 1; ++i)
+  {
+    m_queues.push_back(std::make_unique<Queue>());
+  }
+
+  for (int i = 0; i < num_workers; ++i)
+  {
+    m_workers.emplace_back([this, i] { worker_main(static_cast<size_t>(i)); });
+  }
+}
+
+JobPool::~JobPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_quit = true;
+  }
+  m_wake.notify_all();
+
+  for (auto& worker : m_workers)
+  {
+    worker.join();
+  }
+}
+
+void
+JobPool::parallel_for(size_t count, const Job& job)
+{
+  if (count == 0)
+    return;
+
+  if (m_workers.empty() || count == 1)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      job(i);
+    }
+    return;
+  }
+
+  const size_t slots = m_queues.size();
+  const size_t chunk_size = std::max<size_t>(count / (slots * CHUNKS_PER_THREAD), 1);
+  const size_t chunks = (count + chunk_size - 1) / chunk_size;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_job = &job;
+    m_count = count;
+    m_chunk_size = chunk_size;
+    m_remaining = chunks;
+    m_exception = nullptr;
+  }
+
+  // the queue locks make the job visible to whoever takes a chunk
+  for (size_t chunk = 0; chunk < chunks; ++chunk)
+  {
+    auto& queue = *m_queues[chunk % slots];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.chunks.push_back(chunk);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_generation += 1;
+  }
+  m_wake.notify_all();
+
+  while (run_chunk(slots - 1)) {}
+
+  std::exception_ptr exception;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_remaining == 0; });
+    m_job = nullptr;
+    std::swap(exception, m_exception);
+  }
+
+  if (exception)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
+void
+JobPool::worker_main(size_t slot)
+{
+  uint64_t generation = 0;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_wake.wait(lock, [this, generation] { return m_quit || m_generation != generation; });
+      if (m_quit)
+        return;
+      generation = m_generation;
+    }
+
+    while (run_chunk(slot)) {}
+  }
+}
+
+bool
+JobPool::pop_chunk(size_t slot, size_t& chunk)
+{
+  // own work is taken from the back, stolen work from the front
+  {
+    auto& queue = *m_queues[slot];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.chunks.empty())
+    {
+      chunk = queue.chunks.back();
+      queue.chunks.pop_back();
+      return true;
+    }
+  }
+
+  for (size_t i = 1; i < m_queues.size(); ++i)
+  {
+    auto& queue = *m_queues[(slot + i) % m_queues.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.chunks.empty())
+    {
+      chunk = queue.chunks.front();
+      queue.chunks.pop_front();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool
+JobPool::run_chunk(size_t slot)
+{
+  size_t chunk;
+  if (!pop_chunk(slot, chunk))
+    return false;
+
+  const size_t begin = chunk * m_chunk_size;
+  const size_t end = std::min(begin + m_chunk_size, m_count);
+  try
+  {
+    for (size_t i = begin; i < end; ++i)
+    {
+      (*m_job)(i);
+    }
+  }
+  catch(...)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_exception)
+    {
+      m_exception = std::current_exception();
+    }
+  }
+
+  if (--m_remaining == 0)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_done.notify_all();
+  }
+  return true;
+}
+
+/* EOF */
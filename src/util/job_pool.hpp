@@ -0,0 +1,99 @@
+//  SuperTux
+//  Copyright (C) 2018 Ingo Ruhnke <grumbel@gmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_UTIL_JOB_POOL_HPP
+#define HEADER_SUPERTUX_UTIL_JOB_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+#include "util/currenton.hpp"
+
+/** A set of worker threads for running many small independent jobs.
+
+    parallel_for() splits the work into chunks and deals them out to
+    a queue per thread. A thread works through its own queue and then
+    steals chunks from the others, the calling thread helps along
+    until everything is done. */
+class JobPool final : public Currenton<JobPool>
+{
+public:
+  using Job = std::function<void(size_t index)>;
+
+public:
+  /** Starts one worker less than there are cores */
+  JobPool();
+  explicit JobPool(int num_workers);
+  ~JobPool();
+
+  /** Calls job(i) for every i in [0, count) and returns once all
+      calls have finished. The first exception thrown by a job is
+      rethrown here. Must not be called from within a job. */
+  void parallel_for(size_t count, const Job& job);
+
+  int get_num_workers() const { return static_cast<int>(m_workers.size()); }
+
+private:
+  struct Queue
+  {
+    Queue() : mutex(), chunks() {}
+
+    std::mutex mutex;
+    std::deque<size_t> chunks;
+  };
+
+  void worker_main(size_t slot);
+
+  /** Runs one chunk from the queue of slot or stolen from another
+      queue, false if all queues were empty */
+  bool run_chunk(size_t slot);
+
+  bool pop_chunk(size_t slot, size_t& chunk);
+
+private:
+  std::vector<std::thread> m_workers;
+
+  /** one queue per worker, the last one belongs to the caller */
+  std::vector<std::unique_ptr<Queue> > m_queues;
+
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_done;
+  uint64_t m_generation;
+  bool m_quit;
+
+  const Job* m_job;
+  size_t m_count;
+  size_t m_chunk_size;
+  std::atomic<size_t> m_remaining;
+  std::exception_ptr m_exception;
+
+private:
+  JobPool(const JobPool&) = delete;
+  JobPool& operator=(const JobPool&) = delete;
+};
+
+#endif
+
+/* EOF */
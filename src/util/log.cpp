@@ -17,7 +17,18 @@
 
 #include "util/log.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdio.h>
+#include <streambuf>
+#include <string.h>
+#include <thread>
+#include <vector>
 
 #include "math/rectf.hpp"
 #include "supertux/console.hpp"
@@ -26,6 +37,487 @@
 
 LogLevel g_log_level = LOG_WARNING;
 
+namespace {
+
+/** entries per ring, must be a power of two */
+const size_t LOG_RING_SIZE = 256;
+
+/** bytes per entry, longer messages are split over several entries */
+const size_t LOG_MESSAGE_SIZE = 512;
+
+/** how long the writer sleeps when there is nothing to write */
+const std::chrono::milliseconds LOG_WRITER_INTERVAL(10);
+
+struct LogMessage
+{
+  size_t length;
+  bool console;
+  bool last; /**< false if the message continues in the next entry */
+  char text[LOG_MESSAGE_SIZE];
+};
+
+/** Fixed size single producer, single consumer queue */
+class LogRing final
+{
+public:
+  LogRing() :
+    m_messages(LOG_RING_SIZE),
+    m_head(0),
+    m_tail(0),
+    m_closed(false),
+    m_console_text()
+  {}
+
+  /** Returns the slot to fill next or nullptr if the ring is full */
+  LogMessage* begin_write()
+  {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) >= LOG_RING_SIZE)
+      return nullptr;
+    return &m_messages[head & (LOG_RING_SIZE - 1)];
+  }
+
+  void end_write()
+  {
+    m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /** Number of unread messages, only exact on the producer side */
+  size_t size() const
+  {
+    return m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_acquire);
+  }
+
+  /** Returns the oldest message or nullptr if the ring is empty */
+  const LogMessage* begin_read()
+  {
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail == m_head.load(std::memory_order_acquire))
+      return nullptr;
+    return &m_messages[tail & (LOG_RING_SIZE - 1)];
+  }
+
+  void end_read()
+  {
+    m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /** Marks the ring as abandoned by its producer, the writer frees it
+      once it has been drained */
+  void close() { m_closed.store(true, std::memory_order_release); }
+  bool is_closed() const { return m_closed.load(std::memory_order_acquire); }
+
+  /** console message being put together from its entries, only
+      touched by the consumer */
+  std::string& get_console_text() { return m_console_text; }
+
+private:
+  std::vector<LogMessage> m_messages;
+  std::atomic<size_t> m_head;
+  std::atomic<size_t> m_tail;
+  std::atomic<bool> m_closed;
+  std::string m_console_text;
+
+private:
+  LogRing(const LogRing&) = delete;
+  LogRing& operator=(const LogRing&) = delete;
+};
+
+/** Owns the per-thread rings and the thread that drains them */
+class LogWriter final
+{
+public:
+  LogWriter() :
+    m_rings_mutex(),
+    m_rings(),
+    m_console_ring(),
+    m_console_text(),
+    m_console_open_requested(false),
+    m_wakeup_mutex(),
+    m_wakeup(),
+    m_thread(),
+    m_running(false),
+    m_dropped(0),
+    m_console_dropped(0),
+    m_reported_dropped(0),
+    m_batch()
+  {}
+
+  ~LogWriter()
+  {
+    stop();
+  }
+
+  std::shared_ptr<LogRing> register_ring()
+  {
+    auto ring = std::make_shared<LogRing>();
+    std::lock_guard<std::mutex> lock(m_rings_mutex);
+    m_rings.push_back(ring);
+    return ring;
+  }
+
+  void start()
+  {
+    if (m_running)
+      return;
+
+    m_batch.reserve(LOG_RING_SIZE * LOG_MESSAGE_SIZE);
+    m_running = true;
+    m_thread = std::thread(&LogWriter::run, this);
+  }
+
+  void stop()
+  {
+    if (!m_running)
+      return;
+
+    m_running = false;
+    wakeup();
+    m_thread.join();
+
+    // pick up whatever was committed while the thread shut down
+    write_batch();
+  }
+
+  bool is_running() const { return m_running.load(std::memory_order_relaxed); }
+
+  void wakeup() { m_wakeup.notify_one(); }
+
+  void drop() { m_dropped.fetch_add(1, std::memory_order_relaxed); }
+  uint64_t get_dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+  uint64_t get_console_dropped() const { return m_console_dropped.load(std::memory_order_relaxed); }
+
+  bool pop_console_message(std::string& message)
+  {
+    while (const LogMessage* entry = m_console_ring.begin_read())
+    {
+      m_console_text.append(entry->text, entry->length);
+      const bool last = entry->last;
+      m_console_ring.end_read();
+
+      if (last)
+      {
+        message.swap(m_console_text);
+        m_console_text.clear();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void request_console_open() { m_console_open_requested.store(true, std::memory_order_relaxed); }
+  bool take_console_open_request() { return m_console_open_requested.exchange(false, std::memory_order_relaxed); }
+
+private:
+  void run()
+  {
+    while (m_running)
+    {
+      if (!write_batch())
+      {
+        std::unique_lock<std::mutex> lock(m_wakeup_mutex);
+        m_wakeup.wait_for(lock, LOG_WRITER_INTERVAL);
+      }
+    }
+  }
+
+  /** Collects all pending messages into one buffer and writes it in
+      a single call, returns false if there was nothing to write */
+  bool write_batch()
+  {
+    m_batch.clear();
+
+    {
+      std::lock_guard<std::mutex> lock(m_rings_mutex);
+      for (auto it = m_rings.begin(); it != m_rings.end();)
+      {
+        LogRing& ring = **it;
+
+        // read before draining, so nothing committed before close() is lost
+        const bool closed = ring.is_closed();
+
+        while (const LogMessage* message = ring.begin_read())
+        {
+          m_batch.append(message->text, message->length);
+          if (message->last && (m_batch.empty() || m_batch.back() != '\n'))
+            m_batch += '\n';
+
+          if (message->console)
+          {
+            std::string& text = ring.get_console_text();
+            text.append(message->text, message->length);
+            if (message->last)
+            {
+              forward_to_console(text);
+              text.clear();
+            }
+          }
+          ring.end_read();
+        }
+
+        if (closed)
+          it = m_rings.erase(it);
+        else
+          ++it;
+      }
+    }
+
+    const uint64_t dropped = get_dropped();
+    if (dropped != m_reported_dropped)
+    {
+      m_batch += "[WARNING] log: " + std::to_string(dropped - m_reported_dropped) + " messages dropped\n";
+      m_reported_dropped = dropped;
+    }
+
+    if (m_batch.empty())
+      return false;
+
+    fwrite(m_batch.data(), 1, m_batch.size(), stderr);
+    fflush(stderr);
+    return true;
+  }
+
+  /** Hands a whole message to the main thread, as one or more
+      entries that are either all written or not at all */
+  void forward_to_console(const std::string& text)
+  {
+    size_t length = text.size();
+    while (length > 0 && (text[length - 1] == '\n' || text[length - 1] == '\r'))
+      length -= 1;
+
+    const size_t count = std::max<size_t>(1, (length + LOG_MESSAGE_SIZE - 1) / LOG_MESSAGE_SIZE);
+    if (m_console_ring.size() + count > LOG_RING_SIZE)
+    {
+      m_console_dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      LogMessage* slot = m_console_ring.begin_write();
+      const size_t offset = i * LOG_MESSAGE_SIZE;
+      slot->length = std::min(length - offset, LOG_MESSAGE_SIZE);
+      memcpy(slot->text, text.data() + offset, slot->length);
+      slot->console = true;
+      slot->last = (i == count - 1);
+      m_console_ring.end_write();
+    }
+  }
+
+private:
+  std::mutex m_rings_mutex;
+  std::vector<std::shared_ptr<LogRing> > m_rings;
+
+  /** messages for the ConsoleBuffer, filled by the writer thread and
+      drained by the main thread */
+  LogRing m_console_ring;
+  std::string m_console_text;
+
+  /** set by any thread, acted upon by Console::update() */
+  std::atomic<bool> m_console_open_requested;
+
+  std::mutex m_wakeup_mutex;
+  std::condition_variable m_wakeup;
+  std::thread m_thread;
+  std::atomic<bool> m_running;
+
+  std::atomic<uint64_t> m_dropped;
+  std::atomic<uint64_t> m_console_dropped;
+  uint64_t m_reported_dropped;
+
+  /** messages collected from the rings, written to stderr in one go */
+  std::string m_batch;
+
+private:
+  LogWriter(const LogWriter&) = delete;
+  LogWriter& operator=(const LogWriter&) = delete;
+};
+
+LogWriter& get_log_writer()
+{
+  static LogWriter writer;
+  return writer;
+}
+
+/** Formats a thread's messages into a fixed buffer and commits them to
+    the thread's ring when they get flushed or the next message starts */
+class LogStreamBuffer final : public std::streambuf
+{
+public:
+  LogStreamBuffer() :
+    m_ring(),
+    m_console(false),
+    m_urgent(false),
+    m_continued(false),
+    m_truncated(false),
+    m_buffer()
+  {
+    setp(m_buffer, m_buffer + sizeof(m_buffer));
+  }
+
+  ~LogStreamBuffer()
+  {
+    commit(true);
+    if (m_ring)
+      m_ring->close();
+  }
+
+  void begin(bool console, bool urgent)
+  {
+    commit(true);
+    m_console = console;
+    m_urgent = urgent;
+  }
+
+  void end() { commit(true); }
+
+protected:
+  virtual int overflow(int c) override
+  {
+    commit(false);
+    if (c != traits_type::eof())
+    {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  virtual int sync() override
+  {
+    commit(true);
+    return 0;
+  }
+
+private:
+  /** Commits the buffered text, last is false when the buffer ran
+      full in the middle of a message */
+  void commit(bool last)
+  {
+    const size_t length = static_cast<size_t>(pptr() - pbase());
+    if (length == 0 && !(last && m_continued))
+      return;
+
+    LogWriter& writer = get_log_writer();
+    if (!m_ring)
+      m_ring = writer.register_ring();
+
+    // a part that isn't the last keeps one entry free, so that a
+    // message that got started can always be finished
+    const size_t needed = last ? 1 : 2;
+    LogMessage* message = nullptr;
+    if ((last || !m_truncated) && m_ring->size() + needed <= LOG_RING_SIZE)
+      message = m_ring->begin_write();
+
+    if (message)
+    {
+      memcpy(message->text, pbase(), length);
+      message->length = length;
+      message->console = m_console;
+      message->last = last;
+      m_ring->end_write();
+
+      // don't wait for the next interval if the ring is about to run full
+      if (m_urgent || m_ring->size() > LOG_RING_SIZE / 2)
+        writer.wakeup();
+    }
+    else if (!m_truncated)
+    {
+      writer.drop();
+    }
+
+    // the rest of a message that lost a part is dropped as well, except
+    // for its end, which closes what was already committed
+    m_truncated = !last && (m_truncated || !message);
+    m_continued = !last;
+    setp(m_buffer, m_buffer + sizeof(m_buffer));
+  }
+
+private:
+  std::shared_ptr<LogRing> m_ring;
+  bool m_console;
+  bool m_urgent;
+  bool m_continued;
+  bool m_truncated;
+  char m_buffer[LOG_MESSAGE_SIZE];
+
+private:
+  LogStreamBuffer(const LogStreamBuffer&) = delete;
+  LogStreamBuffer& operator=(const LogStreamBuffer&) = delete;
+};
+
+struct LogThreadStream
+{
+  LogThreadStream() :
+    buffer(),
+    stream(&buffer)
+  {}
+
+  LogStreamBuffer buffer;
+  std::ostream stream;
+};
+
+LogThreadStream& get_thread_stream()
+{
+  thread_local LogThreadStream thread_stream;
+  return thread_stream;
+}
+
+} // namespace
+
+void
+log_start_async()
+{
+  get_log_writer().start();
+}
+
+void
+log_stop_async()
+{
+  LogWriter& writer = get_log_writer();
+  if (!writer.is_running())
+    return;
+
+  get_thread_stream().stream.flush();
+  writer.stop();
+}
+
+bool
+log_is_async()
+{
+  return get_log_writer().is_running();
+}
+
+uint64_t
+log_get_dropped_messages()
+{
+  return get_log_writer().get_dropped();
+}
+
+uint64_t
+log_get_dropped_console_messages()
+{
+  return get_log_writer().get_console_dropped();
+}
+
+bool
+log_pop_console_message(std::string& message)
+{
+  return get_log_writer().pop_console_message(message);
+}
+
+bool
+log_take_console_open_request()
+{
+  return get_log_writer().take_console_open_request();
+}
+
+LogStatement::~LogStatement()
+{
+  if (log_is_async())
+    get_thread_stream().buffer.end();
+}
+
 static std::ostream& get_logging_instance (bool use_console_buffer = true)
 {
   if (ConsoleBuffer::current() && use_console_buffer)
@@ -34,8 +526,16 @@ static std::ostream& get_logging_instance (bool use_console_buffer = true)
     return (std::cerr);
 }
 
-static std::ostream& log_generic_f (const char *prefix, const char* file, int line, bool use_console_buffer = true)
+static std::ostream& log_generic_f (const char *prefix, const char* file, int line, bool use_console_buffer = true, bool urgent = false)
 {
+  if (log_is_async())
+  {
+    LogThreadStream& thread_stream = get_thread_stream();
+    thread_stream.buffer.begin(use_console_buffer, urgent);
+    thread_stream.stream << prefix << " " << file << ":" << line << " ";
+    return thread_stream.stream;
+  }
+
   get_logging_instance (use_console_buffer) << prefix << " " << file << ":" << line << " ";
   return (get_logging_instance (use_console_buffer));
 }
@@ -52,20 +552,18 @@ std::ostream& log_info_f(const char* file, int line)
 
 std::ostream& log_warning_f(const char* file, int line)
 {
-  if(g_config && g_config->developer_mode &&
-     Console::current() && !Console::current()->hasFocus()) {
-    Console::current()->open();
+  if(g_config && g_config->developer_mode) {
+    get_log_writer().request_console_open();
   }
-  return (log_generic_f ("[WARNING]", file, line));
+  return (log_generic_f ("[WARNING]", file, line, true, true));
 }
 
 std::ostream& log_fatal_f(const char* file, int line)
 {
-  if(g_config && g_config->developer_mode &&
-     Console::current() && !Console::current()->hasFocus()) {
-    Console::current()->open();
+  if(g_config && g_config->developer_mode) {
+    get_log_writer().request_console_open();
   }
-  return (log_generic_f ("[FATAL]", file, line));
+  return (log_generic_f ("[FATAL]", file, line, true, true));
 }
 
 /* Callbacks used by tinygettext */
@@ -18,22 +18,66 @@
 #define HEADER_SUPERTUX_UTIL_LOG_HPP
 
 #include <ostream>
+#include <stdint.h>
+#include <string>
 
 enum LogLevel { LOG_NONE, LOG_FATAL, LOG_WARNING, LOG_INFO, LOG_DEBUG };
 extern LogLevel g_log_level;
 
+/** Ends the message of a log statement once the statement is done, so
+    that output without std::endl doesn't wait in the thread's buffer
+    until the thread logs again */
+class LogStatement final
+{
+public:
+  explicit LogStatement(std::ostream& stream) : m_stream(stream) {}
+  ~LogStatement();
+
+  std::ostream& get() { return m_stream; }
+
+private:
+  std::ostream& m_stream;
+
+private:
+  LogStatement(const LogStatement&) = delete;
+  LogStatement& operator=(const LogStatement&) = delete;
+};
+
 std::ostream& log_debug_f(const char* file, int line, bool use_console_buffer);
-#define log_debug if (g_log_level >= LOG_DEBUG) log_debug_f(__FILE__, __LINE__, true)
-#define log_debug_ if (g_log_level >= LOG_DEBUG) log_debug_f(__FILE__, __LINE__, false)
+#define log_debug if (g_log_level >= LOG_DEBUG) LogStatement(log_debug_f(__FILE__, __LINE__, true)).get()
+#define log_debug_ if (g_log_level >= LOG_DEBUG) LogStatement(log_debug_f(__FILE__, __LINE__, false)).get()
 
 std::ostream& log_info_f(const char* file, int line);
-#define log_info if (g_log_level >= LOG_INFO) log_info_f(__FILE__, __LINE__)
+#define log_info if (g_log_level >= LOG_INFO) LogStatement(log_info_f(__FILE__, __LINE__)).get()
 
 std::ostream& log_warning_f(const char* file, int line);
-#define log_warning if (g_log_level >= LOG_WARNING) log_warning_f(__FILE__, __LINE__)
+#define log_warning if (g_log_level >= LOG_WARNING) LogStatement(log_warning_f(__FILE__, __LINE__)).get()
 
 std::ostream& log_fatal_f(const char* file, int line);
-#define log_fatal if (g_log_level >= LOG_FATAL) log_fatal_f(__FILE__, __LINE__)
+#define log_fatal if (g_log_level >= LOG_FATAL) LogStatement(log_fatal_f(__FILE__, __LINE__)).get()
+
+/** Moves formatting and I/O off the calling threads: messages are
+    committed to a per-thread lock-free ring and written to stderr in
+    batches by a background thread until log_stop_async() is called. */
+void log_start_async();
+void log_stop_async();
+bool log_is_async();
+
+/** Number of messages lost because a thread's ring was full */
+uint64_t log_get_dropped_messages();
+
+/** Number of messages that made it to stderr, but not to the console */
+uint64_t log_get_dropped_console_messages();
+
+/** Fetches the next message the writer thread mirrored for the
+    console, must be called from the main thread. Returns false if
+    there is none. */
+bool log_pop_console_message(std::string& message);
+
+/** Returns true once after a warning asked for the console to be
+    opened, warnings can come from any thread, so the console is only
+    opened from the main thread */
+bool log_take_console_open_request();
 
 void log_info_callback(const std::string& str);
 void log_error_callback(const std::string& str);
@@ -65,6 +65,7 @@ std::string dirname(const std::string& filename)
 
 void register_translation_directory(const std::string& filename)
 {
+  wait_for_dictionary();
   if (g_dictionary_manager) {
     std::string rel_dir = dirname(filename);
     if (rel_dir.empty()) {
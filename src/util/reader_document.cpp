@@ -18,6 +18,7 @@
 
 #include <sexp/parser.hpp>
 #include <sstream>
+#include <unordered_map>
 
 #include "physfs/ifile_stream.hpp"
 #include "util/file_system.hpp"
@@ -30,9 +31,52 @@ ReaderDocument::from_stream(std::istream& stream, const std::string& filename)
   return ReaderDocument(filename, std::move(sx));
 }
 
+namespace {
+
+std::unordered_map<std::string, ReaderDocument>& get_memory_files()
+{
+  static std::unordered_map<std::string, ReaderDocument> memory_files;
+  return memory_files;
+}
+
+} // namespace
+
+void
+ReaderDocument::add_memory_file(const std::string& filename, const ReaderDocument& doc)
+{
+  auto& memory_files = get_memory_files();
+  const std::string key = FileSystem::normalize(filename);
+  memory_files.erase(key);
+  memory_files.emplace(key, doc);
+}
+
+void
+ReaderDocument::remove_memory_file(const std::string& filename)
+{
+  get_memory_files().erase(FileSystem::normalize(filename));
+}
+
+bool
+ReaderDocument::has_memory_file(const std::string& filename)
+{
+  auto& memory_files = get_memory_files();
+  return !memory_files.empty() && memory_files.count(FileSystem::normalize(filename)) != 0;
+}
+
 ReaderDocument
 ReaderDocument::from_file(const std::string& filename)
 {
+  auto& memory_files = get_memory_files();
+  if (!memory_files.empty())
+  {
+    auto it = memory_files.find(FileSystem::normalize(filename));
+    if (it != memory_files.end())
+    {
+      log_debug << "ReaderDocument::parse: " << filename << " (in memory)" << std::endl;
+      return it->second;
+    }
+  }
+
   log_debug << "ReaderDocument::parse: " << filename << std::endl;
 
   IFileStream in(filename);
@@ -47,14 +91,14 @@ ReaderDocument::from_file(const std::string& filename)
 
 ReaderDocument::ReaderDocument(const std::string& filename, sexp::Value sx) :
   m_filename(filename),
-  m_sx(std::move(sx))
+  m_sx(std::make_shared<sexp::Value>(std::move(sx)))
 {
 }
 
 ReaderObject
 ReaderDocument::get_root() const
 {
-  return ReaderObject(*this, m_sx);
+  return ReaderObject(*this, *m_sx);
 }
 
 std::string
@@ -18,6 +18,7 @@
 #define HEADER_SUPERTUX_UTIL_READER_DOCUMENT_HPP
 
 #include <istream>
+#include <memory>
 #include <sexp/value.hpp>
 
 #include "util/reader_object.hpp"
@@ -30,6 +31,14 @@ public:
   static ReaderDocument from_stream(std::istream& stream, const std::string& filename = "<stream>");
   static ReaderDocument from_file(const std::string& filename);
 
+  /** Makes from_file() return doc for filename instead of reading
+      the file, until remove_memory_file() is called. Used to hand
+      levels from the editor to the game without a round trip through
+      the disk. Copies of the document share the parsed data. */
+  static void add_memory_file(const std::string& filename, const ReaderDocument& doc);
+  static void remove_memory_file(const std::string& filename);
+  static bool has_memory_file(const std::string& filename);
+
 public:
   ReaderDocument(const std::string& filename, sexp::Value sx);
 
@@ -42,11 +51,11 @@ public:
   /** Returns the directory of the document */
   std::string get_directory() const;
 
-  const sexp::Value& get_sexp() const { return m_sx; }
+  const sexp::Value& get_sexp() const { return *m_sx; }
 
 private:
   std::string m_filename;
-  sexp::Value m_sx;
+  std::shared_ptr<const sexp::Value> m_sx;
 };
 
 #endif
@@ -0,0 +1,543 @@
+//  SuperTux
+//  Copyright (C) 2018 Ingo Ruhnke <grumbel@gmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "util/reader_document_cache.hpp"
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <ctime>
+#include <future>
+#include <physfs.h>
+#include <sstream>
+#include <stdexcept>
+#include <stdint.h>
+#include <string.h>
+#include <unordered_map>
+#include <vector>
+
+#include "addon/md5.hpp"
+#include "physfs/ofile_stream.hpp"
+#include "physfs/physfs_file_system.hpp"
+#include "supertux/gameconfig.hpp"
+#include "supertux/globals.hpp"
+#include "util/file_system.hpp"
+#include "util/log.hpp"
+
+namespace {
+
+const char CACHE_DIRECTORY[] = "cache/documents";
+const char CACHE_MAGIC[4] = { 'S', 'T', 'D', 'C' };
+
+/** bump whenever the layout changes, old entries are then ignored */
+const uint32_t CACHE_VERSION = 1;
+
+/** entries written on a machine with a different byte order are
+    treated as invalid instead of being converted */
+const uint32_t CACHE_BYTE_ORDER = 0x01020304;
+
+/** the least recently used entries are removed when the cache grows
+    beyond this */
+const uintmax_t CACHE_MAX_SIZE = 32 * 1024 * 1024;
+
+/** the entry being written in the background, there is at most one */
+std::future<void> g_pending_write;
+
+/** the cache is pruned once per run, on its first write */
+bool g_pruned = false;
+
+/** integer runs shorter than this are stored as individual values */
+const size_t MIN_INTEGER_RUN = 4;
+
+enum CacheTag : uint8_t
+{
+  TAG_NIL,
+  TAG_FALSE,
+  TAG_TRUE,
+  TAG_INTEGER,
+  TAG_REAL,
+  TAG_STRING,
+  TAG_SYMBOL,
+  TAG_ARRAY,
+  TAG_INTEGERS
+};
+
+class CacheWriter final
+{
+public:
+  CacheWriter() :
+    m_string_ids(),
+    m_string_table(),
+    m_string_count(0),
+    m_tree()
+  {}
+
+  std::string write(const sexp::Value& sx)
+  {
+    write_value(sx);
+
+    std::string data;
+    data.reserve(sizeof(CACHE_MAGIC) + 4 * sizeof(uint32_t) + m_string_table.size() + m_tree.size());
+    data.append(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    put(data, CACHE_VERSION);
+    put(data, CACHE_BYTE_ORDER);
+    put(data, m_string_count);
+    data += m_string_table;
+    data += m_tree;
+    return data;
+  }
+
+private:
+  template<typename T>
+  static void put(std::string& out, T value)
+  {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  uint32_t intern(const std::string& str)
+  {
+    auto it = m_string_ids.find(str);
+    if (it != m_string_ids.end())
+      return it->second;
+
+    put(m_string_table, static_cast<uint32_t>(str.size()));
+    m_string_table += str;
+    m_string_ids[str] = m_string_count;
+    return m_string_count++;
+  }
+
+  void write_value(const sexp::Value& sx)
+  {
+    switch (sx.get_type())
+    {
+      case sexp::Value::TYPE_NIL:
+        put(m_tree, TAG_NIL);
+        break;
+
+      case sexp::Value::TYPE_BOOLEAN:
+        put(m_tree, sx.as_bool() ? TAG_TRUE : TAG_FALSE);
+        break;
+
+      case sexp::Value::TYPE_INTEGER:
+        put(m_tree, TAG_INTEGER);
+        put(m_tree, static_cast<int32_t>(sx.as_int()));
+        break;
+
+      case sexp::Value::TYPE_REAL:
+        put(m_tree, TAG_REAL);
+        put(m_tree, sx.as_float());
+        break;
+
+      case sexp::Value::TYPE_STRING:
+        put(m_tree, TAG_STRING);
+        put(m_tree, intern(sx.as_string()));
+        break;
+
+      case sexp::Value::TYPE_SYMBOL:
+        put(m_tree, TAG_SYMBOL);
+        put(m_tree, intern(sx.as_string()));
+        break;
+
+      case sexp::Value::TYPE_ARRAY:
+        write_array(sx.as_array());
+        break;
+
+      default:
+        throw std::runtime_error("value type not supported by the document cache");
+    }
+  }
+
+  void write_array(const std::vector<sexp::Value>& arr)
+  {
+    put(m_tree, TAG_ARRAY);
+    put(m_tree, static_cast<uint32_t>(arr.size()));
+
+    size_t i = 0;
+    while (i < arr.size())
+    {
+      size_t run_end = i;
+      while (run_end < arr.size() && arr[run_end].is_integer())
+        ++run_end;
+
+      if (run_end - i >= MIN_INTEGER_RUN)
+      {
+        put(m_tree, TAG_INTEGERS);
+        put(m_tree, static_cast<uint32_t>(run_end - i));
+        for (; i < run_end; ++i)
+          put(m_tree, static_cast<int32_t>(arr[i].as_int()));
+      }
+      else
+      {
+        write_value(arr[i]);
+        ++i;
+      }
+    }
+  }
+
+private:
+  std::unordered_map<std::string, uint32_t> m_string_ids;
+  std::string m_string_table;
+  uint32_t m_string_count;
+  std::string m_tree;
+
+private:
+  CacheWriter(const CacheWriter&) = delete;
+  CacheWriter& operator=(const CacheWriter&) = delete;
+};
+
+class CacheReader final
+{
+public:
+  CacheReader(const std::string& data) :
+    m_data(data),
+    m_pos(0),
+    m_strings()
+  {}
+
+  sexp::Value read()
+  {
+    if (m_data.size() < sizeof(CACHE_MAGIC) ||
+        memcmp(m_data.data(), CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0)
+      throw std::runtime_error("not a document cache entry");
+    m_pos = sizeof(CACHE_MAGIC);
+
+    if (get<uint32_t>() != CACHE_VERSION)
+      throw std::runtime_error("document cache version mismatch");
+    if (get<uint32_t>() != CACHE_BYTE_ORDER)
+      throw std::runtime_error("document cache byte order mismatch");
+
+    const uint32_t string_count = get<uint32_t>();
+    m_strings.reserve(string_count);
+    for (uint32_t i = 0; i < string_count; ++i)
+    {
+      const uint32_t length = get<uint32_t>();
+      check(length);
+      m_strings.emplace_back(m_data, m_pos, length);
+      m_pos += length;
+    }
+
+    sexp::Value sx = read_value(get<CacheTag>());
+    if (m_pos != m_data.size())
+      throw std::runtime_error("trailing data in document cache entry");
+    return sx;
+  }
+
+private:
+  void check(size_t size) const
+  {
+    if (m_data.size() - m_pos < size)
+      throw std::runtime_error("truncated document cache entry");
+  }
+
+  template<typename T>
+  T get()
+  {
+    check(sizeof(T));
+    T value;
+    memcpy(&value, m_data.data() + m_pos, sizeof(T));
+    m_pos += sizeof(T);
+    return value;
+  }
+
+  const std::string& get_string()
+  {
+    const uint32_t id = get<uint32_t>();
+    if (id >= m_strings.size())
+      throw std::runtime_error("invalid string in document cache entry");
+    return m_strings[id];
+  }
+
+  sexp::Value read_value(CacheTag tag)
+  {
+    switch (tag)
+    {
+      case TAG_NIL:
+        return sexp::Value::nil();
+
+      case TAG_FALSE:
+        return sexp::Value::boolean(false);
+
+      case TAG_TRUE:
+        return sexp::Value::boolean(true);
+
+      case TAG_INTEGER:
+        return sexp::Value::integer(get<int32_t>());
+
+      case TAG_REAL:
+        return sexp::Value::real(get<float>());
+
+      case TAG_STRING:
+        return sexp::Value::string(get_string());
+
+      case TAG_SYMBOL:
+        return sexp::Value::symbol(get_string());
+
+      case TAG_ARRAY:
+        return read_array();
+
+      default:
+        throw std::runtime_error("invalid tag in document cache entry");
+    }
+  }
+
+  sexp::Value read_array()
+  {
+    const uint32_t count = get<uint32_t>();
+
+    std::vector<sexp::Value> arr;
+    arr.reserve(std::min<size_t>(count, m_data.size() - m_pos));
+    while (arr.size() < count)
+    {
+      const CacheTag tag = get<CacheTag>();
+      if (tag == TAG_INTEGERS)
+      {
+        const uint32_t run = get<uint32_t>();
+        if (run > count - arr.size())
+          throw std::runtime_error("integer run exceeds array in document cache entry");
+        check(run * sizeof(int32_t));
+
+        const char* p = m_data.data() + m_pos;
+        for (uint32_t i = 0; i < run; ++i, p += sizeof(int32_t))
+        {
+          int32_t value;
+          memcpy(&value, p, sizeof(value));
+          arr.push_back(sexp::Value::integer(value));
+        }
+        m_pos += run * sizeof(int32_t);
+      }
+      else
+      {
+        arr.push_back(read_value(tag));
+      }
+    }
+    return sexp::Value::array(std::move(arr));
+  }
+
+private:
+  const std::string& m_data;
+  size_t m_pos;
+  std::vector<std::string> m_strings;
+
+private:
+  CacheReader(const CacheReader&) = delete;
+  CacheReader& operator=(const CacheReader&) = delete;
+};
+
+bool read_file(const std::string& filename, std::string& data)
+{
+  PHYSFS_File* file = PHYSFS_openRead(filename.c_str());
+  if (!file)
+    return false;
+
+  bool result = false;
+  const PHYSFS_sint64 length = PHYSFS_fileLength(file);
+  if (length >= 0)
+  {
+    data.resize(static_cast<size_t>(length));
+    result = (PHYSFS_readBytes(file, &data[0], static_cast<PHYSFS_uint64>(length)) == length);
+  }
+  PHYSFS_close(file);
+  return result;
+}
+
+void write_file(const std::string& filename, const std::string& data)
+{
+  if (!PHYSFS_exists(CACHE_DIRECTORY) && !PHYSFS_mkdir(CACHE_DIRECTORY))
+  {
+    std::ostringstream msg;
+    msg << "Couldn't create directory '" << CACHE_DIRECTORY << "': " << PHYSFS_getLastErrorCode();
+    throw std::runtime_error(msg.str());
+  }
+
+  // readers must never see a half written entry
+  const std::string tmp_filename = filename + ".tmp";
+  {
+    OFileStream out(tmp_filename);
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    out.flush();
+    if (!out)
+      throw std::runtime_error("Couldn't write '" + tmp_filename + "'");
+  }
+
+  if (!PhysFSFileSystem::rename(tmp_filename, filename))
+    throw std::runtime_error("Couldn't rename '" + tmp_filename + "'");
+}
+
+/** Marks an entry as used, the modification time is what
+    prune_entries() goes by */
+void touch_entry(const std::string& filename)
+{
+  const char* write_dir = PHYSFS_getWriteDir();
+  if (!write_dir)
+    return;
+
+  boost::system::error_code ec;
+  boost::filesystem::last_write_time(FileSystem::join(write_dir, filename), std::time(nullptr), ec);
+}
+
+/** Removes the least recently used entries, and leftovers of
+    interrupted writes, until the cache fits into CACHE_MAX_SIZE.
+    The entry keep is never removed. */
+void prune_entries(const std::string& keep)
+{
+  const char* write_dir = PHYSFS_getWriteDir();
+  if (!write_dir)
+    return;
+
+  namespace fs = boost::filesystem;
+
+  struct Entry
+  {
+    fs::path path;
+    std::time_t time;
+    uintmax_t size;
+  };
+
+  const fs::path keep_path = FileSystem::join(write_dir, keep);
+  std::vector<Entry> entries;
+  uintmax_t total = 0;
+
+  boost::system::error_code ec;
+  for (fs::directory_iterator it(FileSystem::join(write_dir, CACHE_DIRECTORY), ec), end;
+       !ec && it != end; it.increment(ec))
+  {
+    boost::system::error_code entry_ec;
+    if (!fs::is_regular_file(it->status(entry_ec)))
+      continue;
+
+    const uintmax_t size = fs::file_size(it->path(), entry_ec);
+    if (entry_ec)
+      continue;
+
+    total += size;
+    if (it->path() != keep_path)
+      entries.push_back({ it->path(), fs::last_write_time(it->path(), entry_ec), size });
+  }
+
+  if (total <= CACHE_MAX_SIZE)
+    return;
+
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry& lhs, const Entry& rhs) {
+              return lhs.time < rhs.time;
+            });
+
+  for (const auto& entry : entries)
+  {
+    if (total <= CACHE_MAX_SIZE)
+      break;
+
+    boost::system::error_code remove_ec;
+    if (fs::remove(entry.path, remove_ec))
+      total -= entry.size;
+  }
+}
+
+} // namespace
+
+ReaderDocument
+ReaderDocumentCache::from_file(const std::string& filename)
+{
+  if (!g_config || !g_config->document_cache || ReaderDocument::has_memory_file(filename))
+    return ReaderDocument::from_file(filename);
+
+  std::string source;
+  if (!read_file(filename, source))
+  {
+    // leave the error reporting to the regular path
+    return ReaderDocument::from_file(filename);
+  }
+
+  MD5 md5;
+  md5.update(reinterpret_cast<uint8_t*>(&source[0]), static_cast<unsigned int>(source.size()));
+  const std::string cache_filename = std::string(CACHE_DIRECTORY) + "/" + md5.hex_digest() + ".stdc";
+
+  // add-ons are mounted in front of the user directory, entries they
+  // ship must not replace the content of other levels
+  std::string data;
+  if (PhysFSFileSystem::is_in_write_dir(cache_filename) && read_file(cache_filename, data))
+  {
+    try
+    {
+      log_debug << "ReaderDocument::parse: " << filename << " (cached)" << std::endl;
+      auto doc = ReaderDocument(filename, deserialize(data));
+      touch_entry(cache_filename);
+      return doc;
+    }
+    catch(const std::exception& e)
+    {
+      log_warning << "Ignoring broken cache entry '" << cache_filename << "' for '"
+                  << filename << "': " << e.what() << std::endl;
+    }
+  }
+
+  log_debug << "ReaderDocument::parse: " << filename << std::endl;
+  std::istringstream in(source);
+  auto doc = ReaderDocument::from_stream(in, filename);
+
+  std::string entry;
+  try
+  {
+    entry = serialize(doc.get_sexp());
+  }
+  catch(const std::exception& e)
+  {
+    log_info << "Couldn't cache '" << filename << "': " << e.what() << std::endl;
+    return doc;
+  }
+
+  // writing the entry and pruning the cache don't hold up the level
+  finish_writes();
+  const bool prune = !g_pruned;
+  g_pruned = true;
+  g_pending_write = std::async(std::launch::async,
+                               [filename, cache_filename, entry = std::move(entry), prune] {
+                                 try
+                                 {
+                                   write_file(cache_filename, entry);
+                                   if (prune)
+                                     prune_entries(cache_filename);
+                                 }
+                                 catch(const std::exception& e)
+                                 {
+                                   log_info << "Couldn't cache '" << filename << "': " << e.what() << std::endl;
+                                 }
+                               });
+
+  return doc;
+}
+
+void
+ReaderDocumentCache::finish_writes()
+{
+  if (g_pending_write.valid())
+    g_pending_write.get();
+}
+
+std::string
+ReaderDocumentCache::serialize(const sexp::Value& sx)
+{
+  CacheWriter writer;
+  return writer.write(sx);
+}
+
+sexp::Value
+ReaderDocumentCache::deserialize(const std::string& data)
+{
+  CacheReader reader(data);
+  return reader.read();
+}
+
+/* EOF */
@@ -0,0 +1,56 @@
+//  SuperTux
+//  Copyright (C) 2018 Ingo Ruhnke <grumbel@gmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_UTIL_READER_DOCUMENT_CACHE_HPP
+#define HEADER_SUPERTUX_UTIL_READER_DOCUMENT_CACHE_HPP
+
+#include <string>
+
+#include "util/reader_document.hpp"
+
+/** Keeps a compact binary copy of large documents (levels and
+    worldmaps) in the user directory, keyed by the MD5 of their
+    source text, so that loading them again skips the text parser.
+
+    The binary form holds a table of interned strings and symbols and
+    stores runs of integers, like tilemap data, as raw arrays. Only
+    entries in the write directory are used. New entries are written
+    in the background, and once per run the least recently used ones
+    are removed when the cache has grown too large. */
+class ReaderDocumentCache final
+{
+public:
+  /** Like ReaderDocument::from_file(), but goes through the cache
+      and fills it on a miss */
+  static ReaderDocument from_file(const std::string& filename);
+
+  /** Waits for the entry that is still being written in the
+      background, has to be called before PhysFS shuts down */
+  static void finish_writes();
+
+  /** Throws if sx contains values the format can't represent */
+  static std::string serialize(const sexp::Value& sx);
+
+  /** Throws if data is not a valid cache entry */
+  static sexp::Value deserialize(const std::string& data);
+
+private:
+  ReaderDocumentCache() = delete;
+};
+
+#endif
+
+/* EOF */
@@ -16,15 +16,49 @@
 
 #include "util/writer.hpp"
 
+#include <algorithm>
+#include <limits>
+
 #include "physfs/ofile_stream.hpp"
 #include "util/log.hpp"
 
+namespace {
+
+/** m_buffer gets written out once it grows beyond this */
+const size_t BUFFER_FLUSH_SIZE = 64 * 1024;
+
+void append_integer(std::string& buffer, unsigned int value)
+{
+  char digits[std::numeric_limits<unsigned int>::digits10 + 1];
+  char* const end = digits + sizeof(digits);
+  char* p = end;
+  do {
+    *--p = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  buffer.append(p, end);
+}
+
+void append_integer(std::string& buffer, int value)
+{
+  if (value < 0) {
+    buffer += '-';
+    // negate in unsigned arithmetic, so INT_MIN doesn't overflow
+    append_integer(buffer, 0u - static_cast<unsigned int>(value));
+  } else {
+    append_integer(buffer, static_cast<unsigned int>(value));
+  }
+}
+
+} // namespace
+
 Writer::Writer(const std::string& filename) :
   m_filename(filename),
   out(new OFileStream(filename)),
   out_owned(true),
   indent_depth(0),
-  lists()
+  lists(),
+  m_buffer()
 {
   out->precision(10);
 }
@@ -34,7 +68,8 @@ Writer::Writer(std::ostream* newout) :
   out(newout),
   out_owned(false),
   indent_depth(0),
-  lists()
+  lists(),
+  m_buffer()
 {
   out->precision(10);
 }
@@ -138,22 +173,54 @@ void
 Writer::write(const std::string& name,
               const std::vector<int>& value)
 {
-  indent();
-  *out << '(' << name;
-  for(const auto& i : value)
-    *out << " " << i;
-  *out << ")\n";
+  write_integers(name, value, 0);
 }
 
 void
 Writer::write(const std::string& name,
               const std::vector<unsigned int>& value)
+{
+  write_integers(name, value, 0);
+}
+
+void
+Writer::write(const std::string& name,
+              const std::vector<unsigned int>& value,
+              int width)
+{
+  write_integers(name, value, width);
+}
+
+template<typename T>
+void
+Writer::write_integers(const std::string& name,
+                       const std::vector<T>& value,
+                       int width)
 {
   indent();
   *out << '(' << name;
-  for(const auto& i : value)
-    *out << " " << i;
-  *out << ")\n";
+
+  m_buffer.clear();
+  int column = 0;
+  for(const auto& i : value) {
+    if(width > 0 && column == 0) {
+      m_buffer += '\n';
+      m_buffer.append(static_cast<size_t>(indent_depth + 2), ' ');
+    } else {
+      m_buffer += ' ';
+    }
+    append_integer(m_buffer, i);
+
+    if(width > 0 && ++column == width)
+      column = 0;
+
+    if(m_buffer.size() >= BUFFER_FLUSH_SIZE) {
+      out->write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+      m_buffer.clear();
+    }
+  }
+  m_buffer += ")\n";
+  out->write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
 }
 
 void
@@ -198,8 +265,10 @@ Writer::write_escaped_string(const std::string& str)
 void
 Writer::indent()
 {
-  for(int i = 0; i<indent_depth; ++i)
-    *out << ' ';
+  static const char spaces[] = "                                ";
+  const int chunk = static_cast<int>(sizeof(spaces)) - 1;
+  for(int i = indent_depth; i > 0; i -= chunk)
+    out->write(spaces, std::min(i, chunk));
 }
 
 /* EOF */
@@ -38,6 +38,10 @@ public:
   void write(const std::string& name, const std::string& value, bool translatable = false);
   void write(const std::string& name, const std::vector<int>& value);
   void write(const std::string& name, const std::vector<unsigned int>& value);
+
+  /** Writes the values in rows of @c width, e.g. the tiles of a
+      tilemap, a width of 0 puts them all on one line */
+  void write(const std::string& name, const std::vector<unsigned int>& value, int width);
   void write(const std::string& name, const std::vector<float>& value);
   void write(const std::string& name, const std::vector<std::string>& value);
   // add more write-functions when needed...
@@ -48,6 +52,9 @@ private:
   void write_escaped_string(const std::string& str);
   void indent();
 
+  template<typename T>
+  void write_integers(const std::string& name, const std::vector<T>& value, int width);
+
 private:
   std::string m_filename;
   std::ostream* out;
@@ -55,6 +62,10 @@ private:
   int indent_depth;
   std::vector<std::string> lists;
 
+  /** integer lists are formatted into this and handed to the stream
+      in large blocks */
+  std::string m_buffer;
+
 private:
   Writer(const Writer&) = delete;
   Writer & operator=(const Writer&) = delete;
@@ -407,9 +407,9 @@ BitmapFont::draw_chars(Canvas& canvas, bool notshadow, const std::string& text,
         glyph = glyphs[0x20];
 
       // FIXME: not supported! request.color = color;
-      canvas.draw_surface_part(notshadow ?
-                               glyph_surfaces[glyph.surface_idx] :
-                               shadow_surfaces[glyph.surface_idx],
+      canvas.draw_surface_part(*(notshadow ?
+                                 glyph_surfaces[glyph.surface_idx] :
+                                 shadow_surfaces[glyph.surface_idx]),
                                glyph.rect,
                                Rectf(p + glyph.offset, glyph.rect.get_size()),
                                layer,
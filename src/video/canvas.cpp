@@ -103,92 +103,87 @@ Canvas::render(Renderer& renderer, Filter filter)
 }
 
 void
-Canvas::draw_surface(SurfacePtr surface,
+Canvas::draw_surface(const Surface& surface,
                      const Vector& position, float angle, const Color& color, const Blend& blend,
                      int layer)
 {
-  assert(surface);
-
   const auto& cliprect = m_context.get_cliprect();
 
   // discard clipped surface
   if(position.x > cliprect.get_right() ||
      position.y > cliprect.get_bottom() ||
-     position.x + static_cast<float>(surface->get_width()) < cliprect.get_left() ||
-     position.y + static_cast<float>(surface->get_height()) < cliprect.get_top())
+     position.x + static_cast<float>(surface.get_width()) < cliprect.get_left() ||
+     position.y + static_cast<float>(surface.get_height()) < cliprect.get_top())
     return;
 
   auto request = new(m_obst) TextureRequest();
 
   request->type = TEXTURE;
   request->layer = layer;
-  request->flip = m_context.transform().flip ^ surface->get_flip();
+  request->flip = m_context.transform().flip ^ surface.get_flip();
   request->alpha = m_context.transform().alpha;
   request->angle = angle;
   request->blend = blend;
 
-  request->srcrects.emplace_back(Rectf(surface->get_region()));
-  request->dstrects.emplace_back(Rectf(apply_translate(position), Size(surface->get_width(), surface->get_height())));
-  request->texture = surface->get_texture().get();
-  request->displacement_texture = surface->get_displacement_texture().get();
+  request->srcrects.emplace_back(Rectf(surface.get_region()));
+  request->dstrects.emplace_back(Rectf(apply_translate(position), Size(surface.get_width(), surface.get_height())));
+  request->texture = surface.get_texture().get();
+  request->displacement_texture = surface.get_displacement_texture().get();
   request->color = color;
 
   m_requests.push_back(request);
 }
 
 void
-Canvas::draw_surface(SurfacePtr surface, const Vector& position, int layer)
+Canvas::draw_surface(const Surface& surface, const Vector& position, int layer)
 {
   draw_surface(surface, position, 0.0f, Color(1.0f, 1.0f, 1.0f), Blend(), layer);
 }
 
 void
-Canvas::draw_surface_scaled(SurfacePtr surface, const Rectf& dstrect,
+Canvas::draw_surface_scaled(const Surface& surface, const Rectf& dstrect,
                             int layer, const PaintStyle& style)
 {
-  draw_surface_part(surface, Rectf(0.0f, 0.0f, static_cast<float>(surface->get_width()), static_cast<float>(surface->get_height())),
+  draw_surface_part(surface, Rectf(0.0f, 0.0f, static_cast<float>(surface.get_width()), static_cast<float>(surface.get_height())),
                     dstrect, layer, style);
 }
 
 void
-Canvas::draw_surface_part(SurfacePtr surface, const Rectf& srcrect, const Rectf& dstrect,
+Canvas::draw_surface_part(const Surface& surface, const Rectf& srcrect, const Rectf& dstrect,
                           int layer, const PaintStyle& style)
 {
-  assert(surface);
-
   auto request = new(m_obst) TextureRequest();
 
   request->type = TEXTURE;
   request->layer = layer;
-  request->flip = m_context.transform().flip ^ surface->get_flip();
+  request->flip = m_context.transform().flip ^ surface.get_flip();
   request->alpha = m_context.transform().alpha * style.get_alpha();
   request->blend = style.get_blend();
 
   request->srcrects.emplace_back(srcrect);
   request->dstrects.emplace_back(apply_translate(dstrect.p1), dstrect.get_size());
-  request->texture = surface->get_texture().get();
-  request->displacement_texture = surface->get_displacement_texture().get();
+  request->texture = surface.get_texture().get();
+  request->displacement_texture = surface.get_displacement_texture().get();
   request->color = style.get_color();
 
   m_requests.push_back(request);
 }
 
 void
-Canvas::draw_surface_batch(SurfacePtr surface,
+Canvas::draw_surface_batch(const Surface& surface,
                            const std::vector<Rectf>& srcrects,
                            const std::vector<Rectf>& dstrects,
                            const Color& color,
-                           int layer)
+                           int layer, const Blend& blend)
 {
-  assert(surface != nullptr);
-
   auto request = new(m_obst) TextureRequest();
 
   request->type = TEXTURE;
   request->layer = layer;
-  request->flip = m_context.transform().flip ^ surface->get_flip();
+  request->flip = m_context.transform().flip ^ surface.get_flip();
   request->alpha = m_context.transform().alpha;
   request->color = color;
+  request->blend = blend;
 
   request->srcrects = srcrects;
   request->dstrects = dstrects;
@@ -197,8 +192,8 @@ Canvas::draw_surface_batch(SurfacePtr surface,
     dstrect = Rectf(apply_translate(dstrect.p1), dstrect.get_size());
   }
 
-  request->texture = surface->get_texture().get();
-  request->displacement_texture = surface->get_displacement_texture().get();
+  request->texture = surface.get_texture().get();
+  request->displacement_texture = surface.get_displacement_texture().get();
 
   m_requests.push_back(request);
 }
@@ -36,6 +36,7 @@
 
 class DrawingContext;
 class Renderer;
+class Surface;
 class VideoSystem;
 struct DrawingRequest;
 
@@ -48,18 +49,21 @@ public:
   Canvas(DrawingContext& context, obstack& obst);
   ~Canvas();
 
-  void draw_surface(SurfacePtr surface, const Vector& position, int layer);
-  void draw_surface(SurfacePtr surface, const Vector& position, float angle, const Color& color, const Blend& blend,
+  /** The surface functions only keep plain pointers to the textures
+      of the surface, whoever owns the surface has to keep it alive
+      until the frame is rendered */
+  void draw_surface(const Surface& surface, const Vector& position, int layer);
+  void draw_surface(const Surface& surface, const Vector& position, float angle, const Color& color, const Blend& blend,
                     int layer);
-  void draw_surface_part(SurfacePtr surface, const Rectf& srcrect, const Rectf& dstrect,
+  void draw_surface_part(const Surface& surface, const Rectf& srcrect, const Rectf& dstrect,
                          int layer, const PaintStyle& style = PaintStyle());
-  void draw_surface_scaled(SurfacePtr surface, const Rectf& dstrect,
+  void draw_surface_scaled(const Surface& surface, const Rectf& dstrect,
                            int layer, const PaintStyle& style = PaintStyle());
-  void draw_surface_batch(SurfacePtr surface,
+  void draw_surface_batch(const Surface& surface,
                           const std::vector<Rectf>& srcrects,
                           const std::vector<Rectf>& dstrects,
                           const Color& color,
-                          int layer);
+                          int layer, const Blend& blend = Blend());
   void draw_text(FontPtr font, const std::string& text,
                  const Vector& position, FontAlignment alignment, int layer, const Color& color = Color(1.0,1.0,1.0));
   /** Draw text to the center of the screen */
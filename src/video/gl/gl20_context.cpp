@@ -23,7 +23,10 @@
 
 #ifndef USE_OPENGLES2
 
-GL20Context::GL20Context()
+GL20Context::GL20Context() :
+  m_blend_valid(false),
+  m_blend_src(GL_ONE),
+  m_blend_dst(GL_ZERO)
 {
 }
 
@@ -37,6 +40,8 @@ GL20Context::bind()
   glDisable(GL_DEPTH_TEST);
   glDisable(GL_CULL_FACE);
   glEnable(GL_BLEND);
+
+  m_blend_valid = false;
 }
 
 void
@@ -67,7 +72,15 @@ GL20Context::ortho(float width, float height, bool vflip)
 void
 GL20Context::blend_func(GLenum src, GLenum dst)
 {
+  if (m_blend_valid && m_blend_src == src && m_blend_dst == dst)
+    return;
+
   glBlendFunc(src, dst);
+
+  m_blend_valid = true;
+  m_blend_src = src;
+  m_blend_dst = dst;
+  m_stats.state_changes += 1;
 }
 
 void
@@ -77,6 +90,7 @@ GL20Context::set_positions(const float* data, size_t size)
   glEnableClientState(GL_VERTEX_ARRAY);
   glVertexPointer(2, GL_FLOAT, 0, data);
   assert_gl();
+  m_stats.bytes_uploaded += size;
 }
 
 void
@@ -86,6 +100,7 @@ GL20Context::set_texcoords(const float* data, size_t size)
   glEnableClientState(GL_TEXTURE_COORD_ARRAY);
   glTexCoordPointer(2, GL_FLOAT, 0, data);
   assert_gl();
+  m_stats.bytes_uploaded += size;
 }
 
 void
@@ -103,6 +118,7 @@ GL20Context::set_colors(const float* data, size_t size)
   glEnableClientState(GL_COLOR_ARRAY);
   glColorPointer(4, GL_FLOAT, 0, data);
   assert_gl();
+  m_stats.bytes_uploaded += size;
 }
 
 void
@@ -121,6 +137,7 @@ GL20Context::bind_texture(const Texture& texture, const Texture* displacement_te
   glEnable(GL_TEXTURE_2D);
   glBindTexture(GL_TEXTURE_2D, static_cast<const GLTexture&>(texture).get_handle());
   assert_gl();
+  m_stats.state_changes += 1;
 
   Vector animate = static_cast<const GLTexture&>(texture).get_sampler().get_animate();
   if (animate.x == 0.0f && animate.y == 0.0f)
@@ -157,6 +174,7 @@ GL20Context::draw_arrays(GLenum type, GLint first, GLsizei count)
   assert_gl();
   glDrawArrays(type, first, count);
   assert_gl();
+  m_stats.draw_calls += 1;
 }
 
 #endif
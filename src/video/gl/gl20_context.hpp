@@ -48,6 +48,11 @@ public:
 
   virtual bool supports_framebuffer() const override { return false; }
 
+private:
+  bool m_blend_valid;
+  GLenum m_blend_src;
+  GLenum m_blend_dst;
+
 private:
   GL20Context(const GL20Context&) = delete;
   GL20Context& operator=(const GL20Context&) = delete;
@@ -16,6 +16,8 @@
 
 #include "video/gl/gl33core_context.hpp"
 
+#include <limits>
+
 #include "supertux/globals.hpp"
 #include "video/color.hpp"
 #include "video/gl/gl_program.hpp"
@@ -31,7 +33,13 @@ GL33CoreContext::GL33CoreContext(GLVideoSystem& video_system) :
   m_white_texture(),
   m_black_texture(),
   m_grey_texture(),
-  m_transparent_texture()
+  m_transparent_texture(),
+  m_bound_textures(),
+  m_blend_valid(false),
+  m_blend_src(GL_ONE),
+  m_blend_dst(GL_ZERO),
+  m_animate(),
+  m_displacement_animate()
 {
   m_program.reset(new GLProgram);
   m_vertex_arrays.reset(new GLVertexArrays(*this));
@@ -39,6 +47,8 @@ GL33CoreContext::GL33CoreContext(GLVideoSystem& video_system) :
   m_black_texture.reset(new GLTexture(1, 1, Color::BLACK));
   m_grey_texture.reset(new GLTexture(1, 1, Color::from_rgba8888(128, 128, 0, 0)));
   m_transparent_texture.reset(new GLTexture(1, 1, Color(1.0f, 0, 0, 0)));
+
+  invalidate_state();
 }
 
 GL33CoreContext::~GL33CoreContext()
@@ -52,6 +62,8 @@ GL33CoreContext::bind()
   glDisable(GL_CULL_FACE);
   glEnable(GL_BLEND);
 
+  invalidate_state();
+
   m_program->bind();
   m_vertex_arrays->bind();
 
@@ -61,16 +73,15 @@ GL33CoreContext::bind()
   if (back_renderer->is_rendering() || !back_renderer->get_texture())
   {
     texture = m_black_texture.get();
-    glUniform1f(m_program->get_uniform_location("backbuffer"), 0.0f);
+    glUniform1f(m_program->get_backbuffer_location(), 0.0f);
   }
   else
   {
     texture = static_cast<GLTexture*>(back_renderer->get_texture().get());
-    glUniform1f(m_program->get_uniform_location("backbuffer"), 1.0f);
+    glUniform1f(m_program->get_backbuffer_location(), 1.0f);
   }
 
-  glActiveTexture(GL_TEXTURE2);
-  glBindTexture(GL_TEXTURE_2D, texture->get_handle());
+  bind_texture_unit(2, texture->get_handle());
 
   const float tsx =
     static_cast<float>(texture->get_image_width()) /
@@ -92,14 +103,14 @@ GL33CoreContext::bind()
     0.0, sy, 0,
     tx, ty, 1.0,
   };
-  glUniformMatrix3fv(m_program->get_uniform_location("fragcoord2uv"),
+  glUniformMatrix3fv(m_program->get_fragcoord2uv_location(),
                      1, false, matrix);
 
-  glUniform1i(m_program->get_uniform_location("diffuse_texture"), 0);
-  glUniform1i(m_program->get_uniform_location("displacement_texture"), 1);
-  glUniform1i(m_program->get_uniform_location("framebuffer_texture"), 2);
+  glUniform1i(m_program->get_diffuse_texture_location(), 0);
+  glUniform1i(m_program->get_displacement_texture_location(), 1);
+  glUniform1i(m_program->get_framebuffer_texture_location(), 2);
 
-  glUniform1f(m_program->get_uniform_location("game_time"), g_game_time);
+  glUniform1f(m_program->get_game_time_location(), g_game_time);
 }
 
 void
@@ -117,26 +128,35 @@ GL33CoreContext::ortho(float width, float height, bool vflip)
     0, 0, 1
   };
 
-  const GLint mvp_loc = m_program->get_uniform_location("modelviewprojection");
-  glUniformMatrix3fv(mvp_loc, 1, false, mvp_matrix);
+  glUniformMatrix3fv(m_program->get_modelviewprojection_location(), 1, false, mvp_matrix);
 }
 
 void
 GL33CoreContext::blend_func(GLenum src, GLenum dst)
 {
+  if (m_blend_valid && m_blend_src == src && m_blend_dst == dst)
+    return;
+
   glBlendFunc(src, dst);
+
+  m_blend_valid = true;
+  m_blend_src = src;
+  m_blend_dst = dst;
+  m_stats.state_changes += 1;
 }
 
 void
 GL33CoreContext::set_positions(const float* data, size_t size)
 {
   m_vertex_arrays->set_positions(data, size);
+  m_stats.bytes_uploaded += size;
 }
 
 void
 GL33CoreContext::set_texcoords(const float* data, size_t size)
 {
   m_vertex_arrays->set_texcoords(data, size);
+  m_stats.bytes_uploaded += size;
 }
 
 void
@@ -149,6 +169,7 @@ void
 GL33CoreContext::set_colors(const float* data, size_t size)
 {
   m_vertex_arrays->set_colors(data, size);
+  m_stats.bytes_uploaded += size;
 }
 
 void
@@ -164,55 +185,98 @@ GL33CoreContext::bind_texture(const Texture& texture, const Texture* displacemen
 
   if (displacement_texture && back_renderer->is_rendering())
   {
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_transparent_texture->get_handle());
+    bind_texture_unit(0, m_transparent_texture->get_handle());
   }
   else
   {
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, static_cast<const GLTexture&>(texture).get_handle());
+    bind_texture_unit(0, static_cast<const GLTexture&>(texture).get_handle());
 
     Vector animate = static_cast<const GLTexture&>(texture).get_sampler().get_animate();
 
     animate.x /= static_cast<float>(texture.get_image_width());
     animate.y /= static_cast<float>(texture.get_image_height());
 
-    glUniform2f(m_program->get_uniform_location("animate"), animate.x, animate.y);
+    set_uniform2f(m_program->get_animate_location(), animate.x, animate.y, m_animate);
   }
 
   if (displacement_texture)
   {
-    glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, static_cast<const GLTexture&>(*displacement_texture).get_handle());
+    bind_texture_unit(1, static_cast<const GLTexture&>(*displacement_texture).get_handle());
 
     Vector animate = static_cast<const GLTexture&>(*displacement_texture).get_sampler().get_animate();
 
     animate.x /= static_cast<float>(displacement_texture->get_image_width());
     animate.y /= static_cast<float>(displacement_texture->get_image_height());
 
-    glUniform2f(m_program->get_uniform_location("displacement_animate"), animate.x, animate.y);
+    set_uniform2f(m_program->get_displacement_animate_location(), animate.x, animate.y,
+                  m_displacement_animate);
   }
   else
   {
-    glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, m_grey_texture->get_handle());
+    bind_texture_unit(1, m_grey_texture->get_handle());
   }
 }
 
 void
 GL33CoreContext::bind_no_texture()
 {
-  glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D, m_white_texture->get_handle());
-
-  glActiveTexture(GL_TEXTURE1);
-  glBindTexture(GL_TEXTURE_2D, m_grey_texture->get_handle());
+  bind_texture_unit(0, m_white_texture->get_handle());
+  bind_texture_unit(1, m_grey_texture->get_handle());
 }
 
 void
 GL33CoreContext::draw_arrays(GLenum type, GLint first, GLsizei count)
 {
   glDrawArrays(type, first, count);
+  m_stats.draw_calls += 1;
+}
+
+void
+GL33CoreContext::bind_texture_unit(int unit, GLuint handle)
+{
+  if (m_bound_textures[unit] == handle)
+    return;
+
+  static const GLenum texture_units[] = { GL_TEXTURE0, GL_TEXTURE1, GL_TEXTURE2 };
+
+  glActiveTexture(texture_units[unit]);
+  glBindTexture(GL_TEXTURE_2D, handle);
+
+  // Texture uploads elsewhere bind to whatever unit is active, so
+  // park the active unit on one that isn't used by the shader to
+  // keep the shadowed bindings valid.
+  glActiveTexture(GL_TEXTURE3);
+
+  m_bound_textures[unit] = handle;
+  m_stats.state_changes += 1;
+}
+
+void
+GL33CoreContext::set_uniform2f(GLint location, float x, float y, float* cache)
+{
+  if (cache[0] == x && cache[1] == y)
+    return;
+
+  glUniform2f(location, x, y);
+
+  cache[0] = x;
+  cache[1] = y;
+  m_stats.state_changes += 1;
+}
+
+void
+GL33CoreContext::invalidate_state()
+{
+  for (auto& handle : m_bound_textures) {
+    handle = 0;
+  }
+
+  m_blend_valid = false;
+
+  // NaN never compares equal, so the next upload always goes through
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  m_animate[0] = m_animate[1] = nan;
+  m_displacement_animate[0] = m_displacement_animate[1] = nan;
 }
 
 /* EOF */
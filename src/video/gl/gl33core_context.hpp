@@ -56,6 +56,14 @@ public:
   GLVertexArrays& get_vertex_arrays() const { return *m_vertex_arrays; }
   GLTexture& get_white_texture() const { return *m_white_texture; }
 
+private:
+  /** Bind the texture to the given unit, unless it is already bound there */
+  void bind_texture_unit(int unit, GLuint handle);
+  void set_uniform2f(GLint location, float x, float y, float* cache);
+
+  /** Forget all cached state, forcing the next calls to go through to GL */
+  void invalidate_state();
+
 private:
   GLVideoSystem& m_video_system;
   std::unique_ptr<GLProgram> m_program;
@@ -65,6 +73,15 @@ private:
   std::unique_ptr<GLTexture> m_grey_texture;
   std::unique_ptr<GLTexture> m_transparent_texture;
 
+  /** Shadow of the GL state last set through this context, used to
+      skip redundant texture binds, blend changes and uniform uploads */
+  GLuint m_bound_textures[3];
+  bool m_blend_valid;
+  GLenum m_blend_src;
+  GLenum m_blend_dst;
+  float m_animate[2];
+  float m_displacement_animate[2];
+
 private:
   GL33CoreContext(const GL33CoreContext&) = delete;
   GL33CoreContext& operator=(const GL33CoreContext&) = delete;
@@ -28,7 +28,25 @@ class Texture;
 class GLContext
 {
 public:
-  GLContext() {}
+  /** Counters collected while rendering a single frame */
+  struct FrameStats
+  {
+    FrameStats() :
+      draw_calls(0),
+      state_changes(0),
+      bytes_uploaded(0)
+    {}
+
+    int draw_calls;
+    int state_changes;
+    size_t bytes_uploaded;
+  };
+
+public:
+  GLContext() :
+    m_stats(),
+    m_last_frame_stats()
+  {}
   virtual ~GLContext() {}
 
   virtual void bind() = 0;
@@ -52,6 +70,23 @@ public:
 
   virtual bool supports_framebuffer() const = 0;
 
+  /** Closes the statistics of the current frame, called once per
+      frame after the buffers have been swapped */
+  void end_frame()
+  {
+    m_last_frame_stats = m_stats;
+    m_stats = FrameStats();
+  }
+
+  /** Statistics of the last completed frame */
+  const FrameStats& get_frame_stats() const { return m_last_frame_stats; }
+
+protected:
+  FrameStats m_stats;
+
+private:
+  FrameStats m_last_frame_stats;
+
 private:
   GLContext(const GLContext&) = delete;
   GLContext& operator=(const GLContext&) = delete;
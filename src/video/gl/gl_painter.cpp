@@ -33,6 +33,39 @@
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
 
+namespace {
+
+/** Moves the edges of [lo, hi) that lie inside the image by half a
+    texel towards the middle. Regions of a texture shared by several
+    images (like the tiles of a tileset) would otherwise get the
+    neighbouring texels blended in by linear filtering when they are
+    drawn scaled or off the pixel grid. Regions reaching outside of the image are meant to
+    wrap and are left alone. */
+void inset_region(float& lo, float& hi, float image_size)
+{
+  if (lo < 0.0f || hi > image_size || hi - lo <= 1.0f)
+    return;
+
+  if (lo > 0.0f)
+    lo += 0.5f;
+  if (hi < image_size)
+    hi -= 0.5f;
+}
+
+/** Returns true if [start, end), given in logical coordinates, covers
+    whole pixels and maps the src_size texels of a region onto them
+    one to one. Only then does linear filtering sample nothing but
+    texel centers. */
+bool maps_to_pixels(float start, float end, float scale, float src_size)
+{
+  const float pixel_start = start * scale;
+  const float pixel_end = end * scale;
+  return fabsf(pixel_end - pixel_start - src_size) <= 0.01f &&
+         fabsf(pixel_start - roundf(pixel_start)) <= 0.01f;
+}
+
+} // namespace
+
 GLPainter::GLPainter(GLVideoSystem& video_system, Renderer& renderer) :
   m_video_system(video_system),
   m_renderer(renderer)
@@ -48,6 +81,13 @@ GLPainter::draw_texture(const TextureRequest& request)
 
   assert(request.srcrects.size() == request.dstrects.size());
 
+  // regions drawn one to one onto whole pixels need no inset
+  const bool linear = (texture.get_sampler().get_filter() == GL_LINEAR);
+  const Rect& rect = m_renderer.get_rect();
+  const Size& logical_size = m_renderer.get_logical_size();
+  const float scale_x = static_cast<float>(rect.get_width()) / static_cast<float>(logical_size.width);
+  const float scale_y = static_cast<float>(rect.get_height()) / static_cast<float>(logical_size.height);
+
   std::vector<float> vertices;
   std::vector<float> uvs;
   for(size_t i = 0; i < request.srcrects.size(); ++i)
@@ -57,10 +97,24 @@ GLPainter::draw_texture(const TextureRequest& request)
     const float right  = request.dstrects[i].p2.x;
     const float bottom = request.dstrects[i].p2.y;
 
-    float uv_left = request.srcrects[i].get_left() / static_cast<float>(texture.get_texture_width());
-    float uv_top = request.srcrects[i].get_top() / static_cast<float>(texture.get_texture_height());
-    float uv_right = request.srcrects[i].get_right() / static_cast<float>(texture.get_texture_width());
-    float uv_bottom = request.srcrects[i].get_bottom() / static_cast<float>(texture.get_texture_height());
+    float src_left = request.srcrects[i].get_left();
+    float src_top = request.srcrects[i].get_top();
+    float src_right = request.srcrects[i].get_right();
+    float src_bottom = request.srcrects[i].get_bottom();
+
+    if (linear)
+    {
+      const bool rotated = (request.angle != 0.0f);
+      if (rotated || !maps_to_pixels(left, right, scale_x, src_right - src_left))
+        inset_region(src_left, src_right, static_cast<float>(texture.get_image_width()));
+      if (rotated || !maps_to_pixels(top, bottom, scale_y, src_bottom - src_top))
+        inset_region(src_top, src_bottom, static_cast<float>(texture.get_image_height()));
+    }
+
+    float uv_left = src_left / static_cast<float>(texture.get_texture_width());
+    float uv_top = src_top / static_cast<float>(texture.get_texture_height());
+    float uv_right = src_right / static_cast<float>(texture.get_texture_width());
+    float uv_bottom = src_bottom / static_cast<float>(texture.get_texture_height());
 
     if (request.flip & HORIZONTAL_FLIP)
       std::swap(uv_left, uv_right);
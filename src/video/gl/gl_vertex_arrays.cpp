@@ -60,7 +60,7 @@ GLVertexArrays::set_positions(const float* data, size_t size)
   glBindBuffer(GL_ARRAY_BUFFER, m_positions_buffer);
   glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW);
 
-  int loc = m_context.get_program().get_attrib_location("position");
+  GLint loc = m_context.get_program().get_position_location();
   glVertexAttribPointer(loc, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
   glEnableVertexAttribArray(loc);
   assert_gl();
@@ -73,7 +73,7 @@ GLVertexArrays::set_texcoords(const float* data, size_t size)
   glBindBuffer(GL_ARRAY_BUFFER, m_texcoords_buffer);
   glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW);
 
-  int loc = m_context.get_program().get_attrib_location("texcoord");
+  GLint loc = m_context.get_program().get_texcoord_location();
   glVertexAttribPointer(loc, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
   glEnableVertexAttribArray(loc);
   assert_gl();
@@ -83,7 +83,7 @@ void
 GLVertexArrays::set_texcoord(float u, float v)
 {
   assert_gl();
-  int loc = m_context.get_program().get_attrib_location("texcoord");
+  GLint loc = m_context.get_program().get_texcoord_location();
   glVertexAttrib2f(loc, u, v);
   glDisableVertexAttribArray(loc);
   assert_gl();
@@ -96,7 +96,7 @@ GLVertexArrays::set_colors(const float* data, size_t size)
   glBindBuffer(GL_ARRAY_BUFFER, m_texcoords_buffer);
   glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW);
 
-  int loc = m_context.get_program().get_attrib_location("diffuse");
+  GLint loc = m_context.get_program().get_diffuse_location();
   glVertexAttribPointer(loc, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
   glEnableVertexAttribArray(loc);
   assert_gl();
@@ -106,7 +106,7 @@ void
 GLVertexArrays::set_color(const Color& color)
 {
   assert_gl();
-  int loc = m_context.get_program().get_attrib_location("diffuse");
+  GLint loc = m_context.get_program().get_diffuse_location();
   glVertexAttrib4f(loc, color.red, color.green, color.blue, color.alpha);
   glDisableVertexAttribArray(loc);
   assert_gl();
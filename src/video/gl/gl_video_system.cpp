@@ -338,6 +338,7 @@ GLVideoSystem::flip()
 {
   assert_gl();
   SDL_GL_SwapWindow(m_window);
+  m_context->end_frame();
 }
 
 void
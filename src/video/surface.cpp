@@ -21,6 +21,7 @@
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
 #include "util/string_util.hpp"
+#include "video/sampler.hpp"
 #include "video/texture.hpp"
 #include "video/texture_manager.hpp"
 #include "video/video_system.hpp"
@@ -28,19 +29,11 @@
 SurfacePtr
 Surface::from_reader(const ReaderMapping& mapping, const boost::optional<Rect>& rect)
 {
-  TexturePtr diffuse_texture;
   boost::optional<ReaderMapping> diffuse_texture_mapping;
-  if (mapping.get("diffuse-texture", diffuse_texture_mapping))
-  {
-    diffuse_texture = TextureManager::current()->get(*diffuse_texture_mapping, rect);
-  }
+  mapping.get("diffuse-texture", diffuse_texture_mapping);
 
-  TexturePtr displacement_texture;
   boost::optional<ReaderMapping> displacement_texture_mapping;
-  if (mapping.get("displacement-texture", displacement_texture_mapping))
-  {
-    displacement_texture = TextureManager::current()->get(*displacement_texture_mapping, rect);
-  }
+  mapping.get("displacement-texture", displacement_texture_mapping);
 
   Flip flip = NO_FLIP;
   std::vector<bool> flip_v;
@@ -50,6 +43,27 @@ Surface::from_reader(const ReaderMapping& mapping, const boost::optional<Rect>&
     flip ^= flip_v[1] ? VERTICAL_FLIP : NO_FLIP;
   }
 
+  if (diffuse_texture_mapping && !displacement_texture_mapping)
+  {
+    Rect region;
+    TexturePtr diffuse_texture = TextureManager::current()->get_shared(*diffuse_texture_mapping, rect, region);
+    return SurfacePtr(new Surface(diffuse_texture, TexturePtr(), region, flip));
+  }
+
+  // both textures are drawn with the same coordinates, so they can't
+  // share the textures of their whole images
+  TexturePtr diffuse_texture;
+  if (diffuse_texture_mapping)
+  {
+    diffuse_texture = TextureManager::current()->get(*diffuse_texture_mapping, rect);
+  }
+
+  TexturePtr displacement_texture;
+  if (displacement_texture_mapping)
+  {
+    displacement_texture = TextureManager::current()->get(*displacement_texture_mapping, rect);
+  }
+
   return SurfacePtr(new Surface(diffuse_texture, displacement_texture, flip));
 }
 
@@ -75,8 +89,9 @@ Surface::from_file(const std::string& filename, const boost::optional<Rect>& rec
   {
     if (rect)
     {
-      TexturePtr texture = TextureManager::current()->get(filename, *rect);
-      return SurfacePtr(new Surface(texture, TexturePtr(), NO_FLIP));
+      Rect region;
+      TexturePtr texture = TextureManager::current()->get_shared(filename, rect, Sampler(), region);
+      return SurfacePtr(new Surface(texture, TexturePtr(), region, NO_FLIP));
     }
     else
     {
@@ -137,13 +152,13 @@ Surface::region(const Rect& rect) const
   return surface;
 }
 
-TexturePtr
+const TexturePtr&
 Surface::get_texture() const
 {
   return m_diffuse_texture;
 }
 
-TexturePtr
+const TexturePtr&
 Surface::get_displacement_texture() const
 {
   return m_displacement_texture;
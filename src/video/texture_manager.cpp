@@ -18,6 +18,7 @@
 
 #include <SDL_image.h>
 #include <assert.h>
+#include <limits>
 #include <sstream>
 
 #include "math/rect.hpp"
@@ -35,6 +36,9 @@
 
 namespace {
 
+/** decoded images kept for cutting regions, in bytes */
+const size_t SURFACE_CACHE_SIZE = 32 * 1024 * 1024;
+
 GLenum string2wrap(const std::string& text)
 {
   if (text == "clamp-to-edge")
@@ -77,7 +81,12 @@ GLenum string2filter(const std::string& text)
 
 TextureManager::TextureManager() :
   m_image_textures(),
-  m_surfaces()
+  m_surfaces(),
+  m_surface_memory(0),
+  m_surface_use_count(0),
+  m_surface_hits(0),
+  m_surface_misses(0),
+  m_surface_evictions(0)
 {
 }
 
@@ -92,12 +101,13 @@ TextureManager::~TextureManager()
   }
   m_image_textures.clear();
   m_surfaces.clear();
+  m_surface_memory = 0;
 }
 
-TexturePtr
-TextureManager::get(const ReaderMapping& mapping, const boost::optional<Rect>& region)
+void
+TextureManager::parse_mapping(const ReaderMapping& mapping, const boost::optional<Rect>& region,
+                              std::string& filename, boost::optional<Rect>& rect, Sampler& sampler) const
 {
-  std::string filename;
   if (!mapping.get("file", filename))
   {
     log_warning << "'file' tag missing" << std::endl;
@@ -107,7 +117,6 @@ TextureManager::get(const ReaderMapping& mapping, const boost::optional<Rect>& r
     filename = FileSystem::join(mapping.get_doc().get_directory(), filename);
   }
 
-  boost::optional<Rect> rect;
   std::vector<int> rect_v;
   if (mapping.get("rect", rect_v))
   {
@@ -177,7 +186,28 @@ TextureManager::get(const ReaderMapping& mapping, const boost::optional<Rect>& r
     }
   }
 
-  return get(filename, rect, Sampler(filter, wrap_s, wrap_t, animate));
+  sampler = Sampler(filter, wrap_s, wrap_t, animate);
+}
+
+TexturePtr
+TextureManager::get(const ReaderMapping& mapping, const boost::optional<Rect>& region)
+{
+  std::string filename;
+  boost::optional<Rect> rect;
+  Sampler sampler;
+  parse_mapping(mapping, region, filename, rect, sampler);
+  return get(filename, rect, sampler);
+}
+
+TexturePtr
+TextureManager::get_shared(const ReaderMapping& mapping, const boost::optional<Rect>& region,
+                           Rect& texture_rect)
+{
+  std::string filename;
+  boost::optional<Rect> rect;
+  Sampler sampler;
+  parse_mapping(mapping, region, filename, rect, sampler);
+  return get_shared(filename, rect, sampler, texture_rect);
 }
 
 TexturePtr
@@ -238,6 +268,44 @@ TextureManager::get(const std::string& _filename,
   return texture;
 }
 
+TexturePtr
+TextureManager::get_shared(const std::string& filename,
+                           const boost::optional<Rect>& rect,
+                           const Sampler& sampler,
+                           Rect& texture_rect)
+{
+  // the whole image is cached with the default sampler, wrapping or
+  // animating needs the region's edges to be the texture's edges
+  const Sampler default_sampler;
+  const bool shareable =
+    sampler.get_filter() == default_sampler.get_filter() &&
+    sampler.get_wrap_s() == default_sampler.get_wrap_s() &&
+    sampler.get_wrap_t() == default_sampler.get_wrap_t() &&
+    sampler.get_animate() == default_sampler.get_animate();
+
+  if (!rect || !shareable)
+  {
+    TexturePtr texture = get(filename, rect, sampler);
+    texture_rect = Rect(0, 0, texture->get_image_width(), texture->get_image_height());
+    return texture;
+  }
+
+  TexturePtr texture = get(filename);
+  const Rect image_rect(0, 0, texture->get_image_width(), texture->get_image_height());
+  if (image_rect.contains(*rect))
+  {
+    texture_rect = *rect;
+  }
+  else
+  {
+    log_warning << "Region " << rect->left << "," << rect->top << " "
+                << rect->get_width() << "x" << rect->get_height()
+                << " is outside of '" << filename << "', using the whole image" << std::endl;
+    texture_rect = image_rect;
+  }
+  return texture;
+}
+
 void
 TextureManager::reap_cache_entry(const Texture::Key& key)
 {
@@ -250,6 +318,23 @@ TextureManager::reap_cache_entry(const Texture::Key& key)
   {
     assert(i->second.expired());
     m_image_textures.erase(i);
+
+    // the decoded image is only needed for cutting out more regions,
+    // so it goes along with the last texture made from it
+    const std::string& filename = std::get<0>(key);
+    auto next = m_image_textures.lower_bound(Texture::Key(filename, std::numeric_limits<int>::min(),
+                                                          std::numeric_limits<int>::min(),
+                                                          std::numeric_limits<int>::min(),
+                                                          std::numeric_limits<int>::min()));
+    if (next == m_image_textures.end() || std::get<0>(next->first) != filename)
+    {
+      auto surface = m_surfaces.find(filename);
+      if (surface != m_surfaces.end())
+      {
+        m_surface_memory -= surface->second.size;
+        m_surfaces.erase(surface);
+      }
+    }
   }
 }
 
@@ -270,10 +355,14 @@ TextureManager::create_image_texture(const std::string& filename, const Rect& re
 const SDL_Surface&
 TextureManager::get_surface(const std::string& filename)
 {
+  m_surface_use_count += 1;
+
   auto i = m_surfaces.find(filename);
   if (i != m_surfaces.end())
   {
-    return *i->second;
+    m_surface_hits += 1;
+    i->second.last_use = m_surface_use_count;
+    return *i->second.surface;
   }
   else
   {
@@ -285,8 +374,93 @@ TextureManager::get_surface(const std::string& filename)
       throw std::runtime_error(msg.str());
     }
 
-    return *(m_surfaces[filename] = std::move(image));
+    m_surface_misses += 1;
+    const size_t size = static_cast<size_t>(image->pitch) * static_cast<size_t>(image->h);
+    auto& entry = m_surfaces[filename];
+    entry.surface = std::move(image);
+    entry.size = size;
+    entry.last_use = m_surface_use_count;
+    m_surface_memory += size;
+
+    evict_surfaces(filename);
+    return *entry.surface;
+  }
+}
+
+void
+TextureManager::evict_surfaces(const std::string& keep)
+{
+  while (m_surface_memory > SURFACE_CACHE_SIZE)
+  {
+    auto oldest = m_surfaces.end();
+    for (auto it = m_surfaces.begin(); it != m_surfaces.end(); ++it)
+    {
+      if (it->first != keep &&
+          (oldest == m_surfaces.end() || it->second.last_use < oldest->second.last_use))
+      {
+        oldest = it;
+      }
+    }
+
+    if (oldest == m_surfaces.end())
+      break;
+
+    log_debug << "Evicting image '" << oldest->first << "' from the cache" << std::endl;
+    m_surface_memory -= oldest->second.size;
+    m_surface_evictions += 1;
+    m_surfaces.erase(oldest);
+  }
+}
+
+void
+TextureManager::print_memory_usage(std::ostream& out) const
+{
+  struct Usage
+  {
+    int textures = 0;
+    size_t texture_memory = 0;
+    size_t surface_memory = 0;
+  };
+
+  std::map<std::string, Usage> usage;
+  size_t texture_memory = 0;
+  for (const auto& it : m_image_textures)
+  {
+    TexturePtr texture = it.second.lock();
+    if (!texture)
+      continue;
+
+    // assumes RGBA, which is what nearly all images end up as
+    const size_t size = 4 * static_cast<size_t>(texture->get_texture_width()) *
+      static_cast<size_t>(texture->get_texture_height());
+    auto& file_usage = usage[std::get<0>(it.first)];
+    file_usage.textures += 1;
+    file_usage.texture_memory += size;
+    texture_memory += size;
+  }
+
+  for (const auto& it : m_surfaces)
+  {
+    usage[it.first].surface_memory += it.second.size;
+  }
+
+  for (const auto& it : usage)
+  {
+    out << it.first << ": " << it.second.textures << " texture(s) "
+        << it.second.texture_memory / 1024 << " KiB";
+    if (it.second.surface_memory)
+    {
+      out << ", image " << it.second.surface_memory / 1024 << " KiB";
+    }
+    out << std::endl;
   }
+
+  out << "textures: " << texture_memory / 1024 << " KiB" << std::endl;
+  out << "image cache: " << m_surface_memory / 1024 << " of " << SURFACE_CACHE_SIZE / 1024 << " KiB, "
+      << m_surfaces.size() << " image(s), "
+      << m_surface_hits << " hit(s), "
+      << m_surface_misses << " miss(es), "
+      << m_surface_evictions << " eviction(s)" << std::endl;
 }
 
 TexturePtr
@@ -20,7 +20,9 @@
 #include <config.h>
 #include <map>
 #include <memory>
+#include <ostream>
 #include <set>
+#include <stdint.h>
 #include <string>
 #include <vector>
 #include <boost/optional.hpp>
@@ -51,8 +53,36 @@ public:
                  const boost::optional<Rect>& rect,
                  const Sampler& sampler = Sampler());
 
+  /** Like get(), but instead of copying rect into a texture of its
+      own, the texture of the whole image is returned with rect as the
+      area to draw from in texture_rect. All regions cut from one image
+      then share a single texture. Regions that wrap, animate or use a
+      non-default filter still get their own texture. */
+  TexturePtr get_shared(const ReaderMapping& mapping, const boost::optional<Rect>& region,
+                        Rect& texture_rect);
+  TexturePtr get_shared(const std::string& filename,
+                        const boost::optional<Rect>& rect,
+                        const Sampler& sampler,
+                        Rect& texture_rect);
+
+  /** Writes the memory used by textures and cached images, per
+      file, to out */
+  void print_memory_usage(std::ostream& out) const;
+
 private:
+  /** Reads the filename, rect and sampler of a texture description,
+      region is relative to the rect given in the mapping */
+  void parse_mapping(const ReaderMapping& mapping, const boost::optional<Rect>& region,
+                     std::string& filename, boost::optional<Rect>& rect, Sampler& sampler) const;
+
+  /** Returns the decoded image, which is kept around for cutting
+      further regions out of it until the cache runs over its budget */
   const SDL_Surface& get_surface(const std::string& filename);
+
+  /** Frees the least recently used images until the cache fits its
+      budget again, keep is never freed */
+  void evict_surfaces(const std::string& keep);
+
   void reap_cache_entry(const Texture::Key& key);
 
   TexturePtr create_image_texture(const std::string& filename, const Rect& rect, const Sampler& sampler);
@@ -68,7 +98,22 @@ private:
 
 private:
   std::map<Texture::Key, std::weak_ptr<Texture> > m_image_textures;
-  std::map<std::string, SDLSurfacePtr> m_surfaces;
+
+  struct SurfaceEntry
+  {
+    SDLSurfacePtr surface;
+    size_t size;
+    uint64_t last_use;
+  };
+
+  std::map<std::string, SurfaceEntry> m_surfaces;
+  size_t m_surface_memory;
+  uint64_t m_surface_use_count;
+
+  /** statistics of the image cache */
+  size_t m_surface_hits;
+  size_t m_surface_misses;
+  size_t m_surface_evictions;
 };
 
 #endif
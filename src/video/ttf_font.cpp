@@ -134,7 +134,7 @@ TTFFont::draw_text(Canvas& canvas, const std::string& text,
       }
 
       // draw text
-      canvas.draw_surface(ttf_surface->get_surface(), new_pos.to_int_vec(), 0.0f, color, Blend(), layer);
+      canvas.draw_surface(*ttf_surface->get_surface(), new_pos.to_int_vec(), 0.0f, color, Blend(), layer);
     }
 
     last_y += get_height();
@@ -36,7 +36,7 @@ public:
 public:
   TTFSurface(const SurfacePtr& surface, const Vector& offset);
 
-  SurfacePtr get_surface() { return m_surface; }
+  const SurfacePtr& get_surface() const { return m_surface; }
   Vector get_offset() const { return m_offset; }
 
   int get_width() const;
@@ -569,7 +569,7 @@ WorldMap::draw_status(DrawingContext& context)
           Vector pos = Vector(context.get_width() - picture->get_width(), context.get_height() - picture->get_height());
           context.push_transform();
           context.set_alpha(0.5);
-          context.color().draw_surface(picture, pos, LAYER_FOREGROUND1-1);
+          context.color().draw_surface(*picture, pos, LAYER_FOREGROUND1-1);
           context.pop_transform();
           }
           }
@@ -27,6 +27,7 @@
 #include "util/log.hpp"
 #include "util/reader.hpp"
 #include "util/reader_document.hpp"
+#include "util/reader_document_cache.hpp"
 #include "util/reader_mapping.hpp"
 #include "util/reader_object.hpp"
 #include "worldmap/level_tile.hpp"
@@ -54,7 +55,7 @@ WorldMapParser::load_worldmap(const std::string& filename)
 
   try {
     register_translation_directory(m_worldmap.m_map_filename);
-    auto doc = ReaderDocument::from_file(m_worldmap.m_map_filename);
+    auto doc = ReaderDocumentCache::from_file(m_worldmap.m_map_filename);
     auto root = doc.get_root();
 
     if(root.get_name() != "supertux-level")
@@ -130,6 +131,10 @@ WorldMapParser::load_worldmap(const std::string& filename)
     if (m_worldmap.get_solid_tilemaps().empty())
       throw std::runtime_error("No solid tilemap specified");
 
+    for(const auto& tilemap : m_worldmap.get_objects_by_type<TileMap>()) {
+      tilemap.prefetch_tiles();
+    }
+
     m_worldmap.move_to_spawnpoint("main");
 
   } catch(std::exception& e) {
@@ -17,6 +17,7 @@
 #include <gtest/gtest.h>
 
 #include "supertux/collision.hpp"
+#include "math/aatriangle.hpp"
 #include "math/rectf.hpp"
 
 TEST(collisionTest, intersects_test)
@@ -47,4 +48,22 @@ TEST(collisionTest, intersects_test)
     ASSERT_EQ(true, collision::intersects(r9, r10));
 }
 
+TEST(collisionTest, line_intersects_aatriangle_test)
+{
+    // solid in the bottom left half of the tile
+    AATriangle southwest(Rectf(0.0, 0.0, 32.0, 32.0), AATriangle::SOUTHWEST);
+
+    // passing above the slope, through the empty half
+    ASSERT_EQ(false, collision::line_intersects_aatriangle(southwest, Vector(-10.0, -10.0), Vector(40.0, 10.0)));
+    // passing through the solid half
+    ASSERT_EQ(true, collision::line_intersects_aatriangle(southwest, Vector(-10.0, 20.0), Vector(40.0, 30.0)));
+    // not even touching the tile
+    ASSERT_EQ(false, collision::line_intersects_aatriangle(southwest, Vector(40.0, 0.0), Vector(40.0, 32.0)));
+
+    // solid in the top right half of the tile
+    AATriangle northeast(Rectf(0.0, 0.0, 32.0, 32.0), AATriangle::NORTHEAST);
+    ASSERT_EQ(true, collision::line_intersects_aatriangle(northeast, Vector(-10.0, -10.0), Vector(40.0, 10.0)));
+    ASSERT_EQ(false, collision::line_intersects_aatriangle(northeast, Vector(-10.0, 25.0), Vector(40.0, 35.0)));
+}
+
 /* EOF */
@@ -0,0 +1,73 @@
+//  SuperTux
+//  Copyright (C) 2018 Ingo Ruhnke <grumbel@gmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "util/job_pool.hpp"
+
+TEST(JobPoolTest, every_index_once)
+{
+  for (int workers : { 0, 1, 3 })
+  {
+    JobPool pool(workers);
+    for (size_t count : { 0, 1, 2, 17, 1000 })
+    {
+      std::vector<int> calls(count, 0);
+      pool.parallel_for(count, [&calls](size_t i) { calls[i] += 1; });
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        ASSERT_EQ(1, calls[i]);
+      }
+    }
+  }
+}
+
+TEST(JobPoolTest, reuse)
+{
+  JobPool pool(2);
+  std::vector<size_t> values(100, 0);
+  for (size_t round = 0; round < 100; ++round)
+  {
+    pool.parallel_for(values.size(), [&values, round](size_t i) { values[i] += i * round; });
+  }
+
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    ASSERT_EQ(i * 4950, values[i]);
+  }
+}
+
+TEST(JobPoolTest, exception)
+{
+  JobPool pool(2);
+  ASSERT_THROW(pool.parallel_for(100, [](size_t i) {
+        if (i == 42)
+          throw std::runtime_error("job failed");
+      }), std::runtime_error);
+
+  // the pool is still usable afterwards
+  std::vector<int> calls(10, 0);
+  pool.parallel_for(calls.size(), [&calls](size_t i) { calls[i] = 1; });
+  for (int call : calls)
+  {
+    ASSERT_EQ(1, call);
+  }
+}
+
+/* EOF */
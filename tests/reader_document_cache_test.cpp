@@ -0,0 +1,71 @@
+//  SuperTux
+//  Copyright (C) 2018 Ingo Ruhnke <grumbel@gmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <stdexcept>
+
+#include "util/reader_document.hpp"
+#include "util/reader_document_cache.hpp"
+#include "util/reader_mapping.hpp"
+
+TEST(ReaderDocumentCacheTest, roundtrip)
+{
+  std::istringstream in(
+    "(supertux-test\n"
+    "   (mybool #t)\n"
+    "   (myint -123456789)\n"
+    "   (myfloat 1.125)\n"
+    "   (mystring \"Hello World\")\n"
+    "   (mysymbol Hello)\n"
+    "   (mytiles 0 1 2 3 4 5 6 7 8 9)\n"
+    ")\n");
+  auto doc = ReaderDocument::from_stream(in);
+
+  std::string data = ReaderDocumentCache::serialize(doc.get_sexp());
+  ReaderDocument cached("<cache>", ReaderDocumentCache::deserialize(data));
+
+  auto root = cached.get_root();
+  ASSERT_EQ("supertux-test", root.get_name());
+  auto mapping = root.get_mapping();
+
+  bool mybool = false;
+  mapping.get("mybool", mybool);
+  ASSERT_EQ(true, mybool);
+
+  int myint = 0;
+  mapping.get("myint", myint);
+  ASSERT_EQ(-123456789, myint);
+
+  float myfloat = 0.0f;
+  mapping.get("myfloat", myfloat);
+  ASSERT_EQ(1.125f, myfloat);
+
+  std::string mystring;
+  mapping.get("mystring", mystring);
+  ASSERT_EQ("Hello World", mystring);
+
+  std::vector<unsigned int> mytiles;
+  mapping.get("mytiles", mytiles);
+  ASSERT_EQ((std::vector<unsigned int>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }), mytiles);
+
+  // truncated entries must be rejected, not misread
+  data.pop_back();
+  ASSERT_THROW(ReaderDocumentCache::deserialize(data), std::runtime_error);
+}
+
+/* EOF */
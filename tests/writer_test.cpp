@@ -0,0 +1,56 @@
+//  SuperTux
+//  Copyright (C) 2018 Ingo Ruhnke <grumbel@gmail.com>
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <sstream>
+
+#include "util/reader_document.hpp"
+#include "util/reader_mapping.hpp"
+#include "util/writer.hpp"
+
+TEST(WriterTest, write_integers)
+{
+  std::ostringstream out;
+  {
+    Writer writer(&out);
+    writer.start_list("supertux-test");
+    writer.write("myints", std::vector<int>{ 0, -7, std::numeric_limits<int>::min() });
+    writer.write("myuints", std::vector<unsigned int>{ 1, 20, 300, 4000 });
+    writer.write("mytiles", std::vector<unsigned int>{ 1, 2, 3, 4, 5, 6 }, 3);
+    writer.end_list("supertux-test");
+  }
+
+  ASSERT_EQ("(supertux-test\n"
+            "  (myints 0 -7 -2147483648)\n"
+            "  (myuints 1 20 300 4000)\n"
+            "  (mytiles\n"
+            "    1 2 3\n"
+            "    4 5 6)\n"
+            ")\n",
+            out.str());
+
+  std::istringstream in(out.str());
+  auto doc = ReaderDocument::from_stream(in);
+  auto mapping = doc.get_root().get_mapping();
+
+  std::vector<unsigned int> mytiles;
+  mapping.get("mytiles", mytiles);
+  ASSERT_EQ((std::vector<unsigned int>{ 1, 2, 3, 4, 5, 6 }), mytiles);
+}
+
+/* EOF */